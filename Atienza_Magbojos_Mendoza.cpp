@@ -1,831 +1,7167 @@
+#ifdef _WIN32
+#define NOMINMAX // Keep windows.h from defining min/max macros
+#include <windows.h>
+#include <io.h>
+#include <conio.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <csignal>
+#endif
 #include <iostream>
 #include <vector>
 #include <map>
 #include <string>
-#include <regex>
+#include <regex> // Reference validators for --bench-validators only
 #include <limits>
 #include <cstdlib>
 #include <iomanip>
-#include <algorithm> // for std::find in addOrder();
+#include <algorithm> // std::find_if in BookingEngine::order, BookingEngine::priceAllOrders and BillingEngine::price, std::find in ScriptRunner::parse
 #include <fstream>
+#include <sstream>
 #include <set>
+#include <array>
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+#include <cerrno>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <memory_resource>
+#include <unordered_set>
+#include <random>
+#include <tuple>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <queue>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define FIELD_KERNELS_SSE2 // Baseline on x86-64
+#define FIELD_KERNELS_AVX2 // Built with a target attribute, used only when the CPU reports AVX2
+#elif defined(_M_X64)
+#include <emmintrin.h>
+#define FIELD_KERNELS_SSE2
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(NO_METRICS)
+#include <x86intrin.h>
+#define METRICS_RDTSC // Metric timers read the time stamp counter, converted to seconds only when dumping
+#endif
 
 using namespace std;
 
-bool isValidDateFormat(const string &date){
-    if (date.length() != 10){
-        return false;
-    }
+// Hand-written validators: each one is a single pass over the input and allocates nothing,
+// unlike std::regex which had to be compiled again on every call.
+inline bool isDigitChar(char c){
+    return c >= '0' && c <= '9';
+}
+
+inline bool isLetterChar(char c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline bool isLeapYear(int year){ // Proleptic Gregorian
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+inline int daysInMonth(int year, int month){
+    static const int monthLengths[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : monthLengths[month - 1];
+}
+
+inline bool isCalendarDay(const string &date){ // Month and day exist in that year, once the YYYY-MM-DD shape is known
+    int year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 + (date[3] - '0');
+    int month = (date[5] - '0') * 10 + (date[6] - '0');
+    int day = (date[8] - '0') * 10 + (date[9] - '0');
+    return month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month);
+}
 
-    if (date[4] != '-' || date[7] != '-'){
+bool isValidDate(const string &date){ // YYYY-MM-DD naming a real day, leap years included
+    if (date.length() != 10 || date[4] != '-' || date[7] != '-'){
         return false;
     }
 
-    for (int i = 0; i < date.length(); i++){
-        if (i == 4 || i == 7){
-            continue;
-        }
-
-        if (!isdigit(date[i])){
+    for (int i = 0; i < 4; i++){
+        if (!isDigitChar(date[i])){
             return false;
         }
     }
 
-    // Get the current date
-    time_t now = time(0);
-    struct tm tstruct;
-    char currentDate[11];
-    tstruct = *localtime(&now);
-    strftime(currentDate, sizeof(currentDate), "%Y-%m-%d", &tstruct); // Current date as string
-
-    // Compare entered date with current date
-    if (date < currentDate){
-        return false; // The entered date is in the past
+    if (!isDigitChar(date[5]) || !isDigitChar(date[6]) || !isDigitChar(date[8]) || !isDigitChar(date[9])){
+        return false;
     }
-    return true; // The date format is valid and the date is recent
-}
-
-bool isValidDate(const string &date){
-    regex dateRegex("^\\d{4}-(0[1-9]|1[0-2])-(0[1-9]|[12][0-9]|3[01])$");
-    return regex_match(date, dateRegex);
+    return isCalendarDay(date);
 }
 
 bool isValidContactInput(const string &contactInput){
-    return regex_match(contactInput, regex("^\\d{11}$")); // Allows 11 digits only
-}
+    if (contactInput.length() != 11){ // Allows 11 digits only
+        return false;
+    }
 
-bool isValidCustomerName(const string &customerNameInput){
-    return regex_match(customerNameInput, regex("^[a-zA-Z ]+$")); // Allows letters and spaces only
+    for (char c : contactInput){
+        if (!isDigitChar(c)){
+            return false;
+        }
+    }
+    return true;
 }
 
-class BaseReservation{
-public:
-    virtual void displayCustomerDetails() const = 0; // Pure virtual function for polymorphism
-    virtual void inputCustomerDetails() = 0;         // Pure virtual function for polymorphism
-    virtual ~BaseReservation() {}
-};
-
-class Reservation : public BaseReservation{ // Inherit from BaseReservation
-private:
-    map<string, vector<bool>> bookings; // Key: Date (YYYY-MM-DD), Value: Slots (true=reserved, false=available)
-    static const int totalSlots = 5;    // Number of slots per day (10 AM to 8 PM at 2-hour intervals)
-
-public:
-    Reservation() {}
-
-    bool checkIfValidDate(const string &date){
-        regex dateRegex("^\\d{4}-(0[1-9]|1[0-2])-(0[1-9]|[12][0-9]|3[01])$");
-        return regex_match(date, dateRegex);
+bool isValidCustomerName(const string &customerNameInput){
+    if (customerNameInput.empty()){
+        return false;
     }
 
-    void checkAvailability(const string &date){
-        if (bookings.find(date) == bookings.end()){
-            bookings[date] = vector<bool>(totalSlots, false); // Initialize all slots as available
-        }
-
-        cout << "Availability for " << date << ":\n";
-        for (int i = 0; i < totalSlots; i++){
-            cout << "Slot " << i + 1 << " (" << 10 + 2 * i << ":00 - " << 12 + 2 * i << ":00): "
-                 << (bookings[date][i] ? "Reserved" : "Available") << "\n"; // Show slot status
+    for (char c : customerNameInput){ // Allows letters and spaces only
+        if (!isLetterChar(c) && c != ' '){
+            return false;
         }
     }
+    return true;
+}
 
-    bool reserveSlot(const string &date, int slot){
-        if (bookings.find(date) == bookings.end()){
-            bookings[date] = vector<bool>(totalSlots, false); // Initialize slots if not already done
-        }
+bool isValidEmail(const string &email){ // local@domain.tld with no spaces
+    size_t atPos = email.find('@');
+    if (atPos == string::npos || atPos == 0 || email.find('@', atPos + 1) != string::npos){
+        return false;
+    }
 
-        if (slot < 0 || slot >= totalSlots){ // validation for time slot
-            cout << "Invalid slot number." << endl;
+    for (size_t i = 0; i < atPos; i++){
+        char c = email[i];
+        if (!isLetterChar(c) && !isDigitChar(c) && c != '.' && c != '_' && c != '-' && c != '+'){
             return false;
         }
+    }
 
-        if (bookings[date][slot]){
-            cout << "Slot already reserved." << endl;
+    // Domain: labels of letters, digits and '-' separated by single dots, with at least one dot
+    size_t labelLength = 0;
+    bool hasDot = false;
+    for (size_t i = atPos + 1; i < email.length(); i++){
+        char c = email[i];
+        if (c == '.'){
+            if (labelLength == 0){
+                return false;
+            }
+            hasDot = true;
+            labelLength = 0;
+        } else if (isLetterChar(c) || isDigitChar(c) || c == '-'){
+            labelLength++;
+        } else{
             return false;
         }
-
-        bookings[date][slot] = true; // Mark slot as reserved
-        cout << endl << "Reservation successful for Slot " << slot + 1 << " on " << date << "." << endl;
-        return true;
     }
-    void inputCustomerDetails() override {}         // No input for Reservation, hence not needed here
-    void displayCustomerDetails() const override {} // No details to display for Reservation
+    return hasDot && labelLength > 0;
+}
+
+// Vector field kernels for bulk ingestion. Each field is copied into a zero-padded 16-byte lane and every byte is
+// range-checked against per-position bounds in one compare; lengths and the calendar check stay scalar.
+// The contact + date kernel checks both fields of a row in a single 32-byte pass on AVX2, two 16-byte passes on SSE2.
+struct FieldKernels{
+    const char *name;
+    bool (*contactAndDate)(const string &contact, const string &date);
+    bool (*customerName)(const string &name);
 };
 
-class Menu : public BaseReservation{ // Inherit from BaseReservation
-protected:
-    string category;
-    vector<int> menuID;
-    vector<string> menuName;
-    vector<float> menuPrice;
+alignas(32) static const unsigned char contactDateLow[32] = { // Lane 0: 11 digits; lane 1: YYYY-MM-DD
+    '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', 0, 0, 0, 0, 0,
+    '0', '0', '0', '0', '-', '0', '0', '-', '0', '0', 0, 0, 0, 0, 0, 0};
+alignas(32) static const unsigned char contactDateHigh[32] = {
+    '9', '9', '9', '9', '9', '9', '9', '9', '9', '9', '9', 0, 0, 0, 0, 0,
+    '9', '9', '9', '9', '-', '9', '9', '-', '9', '9', 0, 0, 0, 0, 0, 0};
 
-    void loadMenuData(){
-        if (category == "PAMAWING-GUTOM"){
-            menuID = {0, 1, 2, 3, 4};
-            menuName = {"Calamares", "Chicharon Bulaklak", "Dynamite", "Lumpiang Shanghai", "Lumpiang Sariwa"};
-            menuPrice = {150, 150, 100, 180, 180};
-        } else if (category == "PANGUNAHING PAGKAIN"){
-            menuID = {5, 6, 7, 8, 9};
-            menuName = {"Adobo", "Sinigang", "Dinuguan", "Kare Kare", "Pinakbet"};
-            menuPrice = {450, 450, 400, 500, 400};
-        } else if (category == "PANGHIMAGAS"){
-            menuID = {10, 11, 12, 13, 14};
-            menuName = {"Sorbetes", "Halo Halo", "Leche Flan", "Buko Pandan", "Mais Con Yelo"};
-            menuPrice = {100, 150, 150, 100, 100};
-        } else if (category == "PANULAK"){
-            menuID = {15, 16, 17, 18, 19};
-            menuName = {"Sago't Gulaman", "Mango Shake", "Buko Juice", "Calamansi Juice", "Pineapple Juice"};
-            menuPrice = {100, 120, 80, 80, 80};
-        }
+bool scalarContactAndDate(const string &contact, const string &date){
+    return isValidContactInput(contact) && isValidDate(date);
+}
+
+#ifdef FIELD_KERNELS_SSE2
+inline bool sse2InRange(__m128i bytes, __m128i low, __m128i high){ // Every byte within [low, high], unsigned
+    __m128i aboveLow = _mm_cmpeq_epi8(_mm_max_epu8(bytes, low), bytes);
+    __m128i belowHigh = _mm_cmpeq_epi8(_mm_min_epu8(bytes, high), bytes);
+    return _mm_movemask_epi8(_mm_and_si128(aboveLow, belowHigh)) == 0xFFFF;
+}
+
+bool sse2ContactAndDate(const string &contact, const string &date){
+    if (contact.length() != 11 || date.length() != 10){
+        return false;
     }
+    alignas(16) unsigned char lanes[32] = {};
+    memcpy(lanes, contact.data(), 11);
+    memcpy(lanes + 16, date.data(), 10);
+    const __m128i *low = reinterpret_cast<const __m128i *>(contactDateLow);
+    const __m128i *high = reinterpret_cast<const __m128i *>(contactDateHigh);
+    return sse2InRange(_mm_load_si128(reinterpret_cast<const __m128i *>(lanes)), _mm_load_si128(low), _mm_load_si128(high)) &&
+           sse2InRange(_mm_load_si128(reinterpret_cast<const __m128i *>(lanes + 16)), _mm_load_si128(low + 1), _mm_load_si128(high + 1)) &&
+           isCalendarDay(date);
+}
 
-public:
-    Menu() : category("") {}
+inline bool sse2Letters(__m128i bytes){ // Letters or spaces only
+    __m128i folded = _mm_or_si128(bytes, _mm_set1_epi8(0x20)); // 'A'-'Z' -> 'a'-'z'
+    __m128i aboveA = _mm_cmpeq_epi8(_mm_max_epu8(folded, _mm_set1_epi8('a')), folded);
+    __m128i belowZ = _mm_cmpeq_epi8(_mm_min_epu8(folded, _mm_set1_epi8('z')), folded);
+    __m128i isSpace = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_and_si128(aboveA, belowZ), isSpace)) == 0xFFFF;
+}
 
-    Menu(const string &category) : category(category){
-        loadMenuData(); // Load menu data for the given category
+bool sse2CustomerName(const string &name){
+    size_t length = name.length(), pos = 0;
+    if (length == 0){
+        return false;
+    }
+    for (; pos + 16 <= length; pos += 16){
+        if (!sse2Letters(_mm_loadu_si128(reinterpret_cast<const __m128i *>(name.data() + pos)))){
+            return false;
+        }
     }
+    if (pos == length){
+        return true;
+    }
+    unsigned char tail[16];
+    memset(tail, 'a', sizeof(tail));
+    memcpy(tail, name.data() + pos, length - pos);
+    return sse2Letters(_mm_loadu_si128(reinterpret_cast<const __m128i *>(tail)));
+}
+#endif
 
-    const vector<int> &getMenuIDs() const{
-        return menuID;
+#ifdef FIELD_KERNELS_AVX2
+__attribute__((target("avx2"))) bool avx2ContactAndDate(const string &contact, const string &date){
+    if (contact.length() != 11 || date.length() != 10){
+        return false;
     }
+    alignas(32) unsigned char lanes[32] = {};
+    memcpy(lanes, contact.data(), 11);
+    memcpy(lanes + 16, date.data(), 10);
+    __m256i bytes = _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes));
+    __m256i aboveLow = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, _mm256_load_si256(reinterpret_cast<const __m256i *>(contactDateLow))), bytes);
+    __m256i belowHigh = _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, _mm256_load_si256(reinterpret_cast<const __m256i *>(contactDateHigh))), bytes);
+    return _mm256_movemask_epi8(_mm256_and_si256(aboveLow, belowHigh)) == -1 && isCalendarDay(date);
+}
 
-    void displayMenu() const{
-        int padding = (43 - category.length()) / 2;
-        cout << string(padding, ' ') << category << endl;
-        cout << string(43, '-') << endl;
-        cout << setw(10) << left << "ID"
-             << setw(25) << left << "Name"
-             << setw(10) << left << "Price" << endl;
-        cout << string(43, '-') << endl;
+__attribute__((target("avx2"))) inline bool avx2Letters(__m256i bytes){
+    __m256i folded = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+    __m256i aboveA = _mm256_cmpeq_epi8(_mm256_max_epu8(folded, _mm256_set1_epi8('a')), folded);
+    __m256i belowZ = _mm256_cmpeq_epi8(_mm256_min_epu8(folded, _mm256_set1_epi8('z')), folded);
+    __m256i isSpace = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+    return _mm256_movemask_epi8(_mm256_or_si256(_mm256_and_si256(aboveA, belowZ), isSpace)) == -1;
+}
 
-        for (size_t i = 0; i < menuID.size(); i++){
-            cout << setw(10) << left << menuID[i]
-                 << setw(25) << left << menuName[i]
-                 << setw(10) << left << fixed << setprecision(2)
-                 << menuPrice[i] << endl;
+__attribute__((target("avx2"))) bool avx2CustomerName(const string &name){
+    size_t length = name.length(), pos = 0;
+    if (length == 0){
+        return false;
+    }
+    for (; pos + 32 <= length; pos += 32){
+        if (!avx2Letters(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(name.data() + pos)))){
+            return false;
         }
-        cout << string(43, '-') << endl;
     }
-    void inputCustomerDetails() override {}         // No input for Menu, hence not needed here
-    void displayCustomerDetails() const override {} // No details to display for Menu
-};
+    if (pos == length){
+        return true;
+    }
+    unsigned char tail[32];
+    memset(tail, 'a', sizeof(tail));
+    memcpy(tail, name.data() + pos, length - pos);
+    return avx2Letters(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail)));
+}
+#endif
+
+const FieldKernels scalarFieldKernels = {"scalar", scalarContactAndDate, isValidCustomerName};
+
+vector<FieldKernels> availableFieldKernels(){ // Scalar first, then every vector variant this CPU can run
+    vector<FieldKernels> kernels = {scalarFieldKernels};
+#ifdef FIELD_KERNELS_SSE2
+    kernels.push_back(FieldKernels{"sse2", sse2ContactAndDate, sse2CustomerName});
+#endif
+#ifdef FIELD_KERNELS_AVX2
+    if (__builtin_cpu_supports("avx2")){
+        kernels.push_back(FieldKernels{"avx2", avx2ContactAndDate, avx2CustomerName});
+    }
+#endif
+    return kernels;
+}
 
-class Customer : public BaseReservation{ // Inherit from BaseReservation
-private:
-    string customerName;
-    string contactNumber;
-    string customerEmail;
-    string customerID;
+const FieldKernels &fieldKernels(){ // Widest kernel set the CPU supports, picked once
+    static const FieldKernels best = availableFieldKernels().back();
+    return best;
+}
 
-    static set<string> customerIDs;
+int daysFromCivil(int year, int month, int day){ // Day number of a calendar date, 0 = 1970-01-01
+    year -= month <= 2; // Count years from March so the leap day is the last day of the year
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
 
-public:
-    Customer() {}
+// Converts a YYYY-MM-DD string (already checked by isValidDate) into a day number
+int dateToDayNumber(const string &date){
+    return daysFromCivil((date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 + (date[3] - '0'),
+                         (date[5] - '0') * 10 + (date[6] - '0'), (date[8] - '0') * 10 + (date[9] - '0'));
+}
 
-    Customer(string name, string contact, string email, string id){
-        customerName = name;
-        contactNumber = contact;
-        customerEmail = email;
-        customerID = id; 
+bool parseDate(const string &date, int &dayNumber){ // Valid calendar date -> day number in one call
+    if (!isValidDate(date)){
+        return false;
     }
+    dayNumber = dateToDayNumber(date);
+    return true;
+}
 
-    string getCustomerName() const { return customerName; }
-    string getCustomerID() const { return customerID; }
-
-    void inputCustomerDetails() override {
-        cin.ignore();
-        bool isCustomerNameValid = false;
-
-        do {
-            system("cls");
-            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
-            cout << "Enter your name: ";
-            getline(cin, customerName);
-
-            if (isValidCustomerName(customerName)) {
-                isCustomerNameValid = true;
-            } else {
-                cout << "Invalid name. It should only contain letters and spaces." << endl;
-                system("pause");
-            }
-        } while (!isCustomerNameValid);
+string dayNumberToDate(int dayNumber){ // Inverse of dateToDayNumber
+    dayNumber += 719468;
+    int era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    int dayOfEra = dayNumber - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int shiftedMonth = (5 * dayOfYear + 2) / 153;
+    int day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    int month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    int year = yearOfEra + era * 400 + (month <= 2);
+
+    string date = "0000-00-00"; // 4-digit years only, like isValidDate
+    date[0] = '0' + year / 1000 % 10;
+    date[1] = '0' + year / 100 % 10;
+    date[2] = '0' + year / 10 % 10;
+    date[3] = '0' + year % 10;
+    date[5] = '0' + month / 10;
+    date[6] = '0' + month % 10;
+    date[8] = '0' + day / 10;
+    date[9] = '0' + day % 10;
+    return date;
+}
 
-        bool isCustomerIDValid = false;
-        do {
-            system("cls");
-            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
-            cout << "Name: " << customerName << endl << endl;
-            cout << "Enter your ID: ";
-            getline(cin, customerID);
+// Local date as a day number. localtime only runs again once the clock passes the next local midnight;
+// every other call is a time() read and two atomic loads.
+int todayDayNumber(){
+    static atomic<long long> nextMidnight(0);
+    static atomic<int> today(0);
+
+    time_t now = time(nullptr);
+    if (now >= nextMidnight.load(memory_order_acquire)){
+        tm local;
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        today.store(daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday), memory_order_relaxed);
+        local.tm_mday += 1; // mktime normalises the day after into the next month or year
+        local.tm_hour = 0;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        local.tm_isdst = -1;
+        nextMidnight.store(static_cast<long long>(mktime(&local)), memory_order_release);
+    }
+    return today.load(memory_order_relaxed);
+}
 
-            if (customerIDs.find(customerID) != customerIDs.end()) {
-                cout << "Customer ID already exists. Please enter a unique ID." << endl;
-                system("pause");
-            } else {
-                isCustomerIDValid = true;
-                customerIDs.insert(customerID);
-            }
-        } while (!isCustomerIDValid);
+bool isValidDateFormat(const string &date){ // A real YYYY-MM-DD date that is today or later
+    int dayNumber;
+    return parseDate(date, dayNumber) && dayNumber >= todayDayNumber();
+}
 
-            bool isContactNumberValid = false;
-            do {
-                system("cls");
-                cout << "INPUT CUSTOMER DETAILS" << endl << endl;
-                cout << "Name: " << customerName << endl;
-                cout << "ID: " << customerID << endl << endl;
-                cout << "Enter your contact number: ";
-                getline(cin, contactNumber);
+inline int lowestSetBit(unsigned long long bits){ // Index of the lowest 1 bit; bits must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1ULL)){
+        bits >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
 
-                if (isValidContactInput(contactNumber)) {
-                    isContactNumberValid = true;
-                } else {
-                    cout << "Invalid contact number. Please try again." << endl;
-                    system("pause");
-                }
-            } while (!isContactNumberValid);
+inline int bitLength(unsigned long long bits){ // Position of the highest 1 bit plus one; 0 for 0
+#if defined(__GNUC__) || defined(__clang__)
+    return bits ? 64 - __builtin_clzll(bits) : 0;
+#else
+    int length = 0;
+    for (; bits; bits >>= 1){
+        length++;
+    }
+    return length;
+#endif
+}
 
-            system("cls");
-            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
-            cout << "Name: " << customerName << endl;
-            cout << "ID: " << customerID << endl;
-            cout << "Contact Number: " << contactNumber << endl << endl;
-            cout << "Enter your email: ";
-            getline(cin, customerEmail);
+// Hot-path metrics: per-thread call counters and latency histograms, dumped in the Prometheus text format.
+// Every call is counted; one call in METRICS_SAMPLE_EVERY is timed, since reading the clock twice costs more
+// than many of the operations it would time. Build with -DNO_METRICS to compile every timer out.
+#ifndef NO_METRICS
+#ifndef METRICS_SAMPLE_EVERY
+#define METRICS_SAMPLE_EVERY 16 // A power of two; 1 times every call
+#endif
+
+enum Metric{
+    MetricCheckDate, MetricRegister, MetricReserve, MetricSeatParty, MetricMove, MetricCancel, MetricWaitlist, MetricOrder,
+    MetricPay, MetricFindCustomer, MetricRangeQuery, MetricImport, MetricValidateBatch, MetricExport,
+    MetricLogAppend, MetricLogSync, MetricStoreAppend, MetricStoreUpdate, MetricStoreRemap, MetricCheckpoint, // File I/O
+    metricCount
+};
 
-            system("cls");
-            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
-            cout << "Name: " << customerName << endl;
-            cout << "ID: " << customerID << endl;
-            cout << "Contact Number: " << contactNumber << endl;
-            cout << "Email: " << customerEmail << endl << endl;
-            system("pause");
-    }
+struct MetricInfo{
+    bool isIO;             // reservation_io_seconds instead of reservation_operation_seconds
+    const char *operation; // Label value
+};
 
-    void displayCustomerDetails() const override{ // Display customer details
-        system("cls");
-        cout << "Customer Details:" << endl;
-        cout << "Name: " << customerName << endl;
-        cout << "Contact Number: " << contactNumber << endl;
-        cout << "Email: " << customerEmail << endl;
-        cout << "Customer ID: " << customerID << endl;
-    }
-
-    void saveToFile() const{ // Save customer details to a file
-        ofstream outFile("customerss.txt", ios::app); // Open in append mode
-        if (outFile.is_open()){
-            outFile << "Customer Details:" << endl;
-            outFile << "Name: " << customerName << endl;
-            outFile << "Contact Number: " << contactNumber << endl;
-            outFile << "Email: " << customerEmail << endl;
-            outFile << "Customer ID: " << customerID << endl;
-            outFile << "-------------------------" << endl;
-            outFile.close(); // Close file after writing
-            cout << endl << "Customer details saved to file successfully." << endl;
-            system("pause");
-        } else{
-            cout << endl << "Error: Unable to open file for writing." << endl;
-            system("pause");
-        }
-    }
+const MetricInfo metricInfo[metricCount] = {
+    {false, "check_date"}, {false, "register"}, {false, "reserve"}, {false, "seat_party"}, {false, "move"}, {false, "cancel"},
+    {false, "waitlist"}, {false, "order"}, {false, "pay"}, {false, "find_customer"}, {false, "range_query"}, {false, "import"},
+    {false, "validate_batch"}, {false, "export"},
+    {true, "wal_append"}, {true, "wal_sync"}, {true, "store_append"}, {true, "store_update"}, {true, "store_remap"}, {true, "checkpoint"}
 };
 
-set<string> Customer::customerIDs;
+inline unsigned long long metricTicks(){
+#ifdef METRICS_RDTSC
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
 
-class TableArea : public BaseReservation{ // Inherit from BaseReservation
+class Metrics{ // Each thread owns its cells and is their only writer; a dump sums every thread's cells
 private:
-    int tableId, numberOfSeats;
-    bool isAvailable;
-
-public:
-    TableArea(int tableId, int numberOfSeats, bool isAvailable) : tableId(tableId), numberOfSeats(numberOfSeats), isAvailable(isAvailable) {}
+    static const int bucketCount = 12; // Bucket b < 4^b * 256 ticks, the last one unbounded
+
+    struct Cells{
+        atomic<unsigned long long> calls[metricCount];
+        atomic<unsigned long long> ticks[metricCount]; // Of the timed calls only
+        atomic<unsigned long long> buckets[metricCount][bucketCount];
+        Cells(){
+            for (int metric = 0; metric < metricCount; metric++){
+                calls[metric].store(0, memory_order_relaxed);
+                ticks[metric].store(0, memory_order_relaxed);
+                for (auto &bucket : buckets[metric]){
+                    bucket.store(0, memory_order_relaxed);
+                }
+            }
+        }
+    };
 
-    void viewAvailableAreas(){
-        cout << "Available Tables:" << endl;
-        cout << "Table 1: Good for 2 people" << endl;
-        cout << "Table 2: Good for 2 people" << endl;
-        cout << "Table 3: Good for 4 people" << endl;
-        cout << "Table 4: Good for 4 people" << endl;
-        cout << "Table 5: Good for 6 people" << endl;
-        cout << "Table 6: Good for 6 people" << endl;
-        cout << "Table 7: Good for 8 people" << endl;
-        cout << "Table 8: Good for 8 people" << endl;
-        cout << "Table 9: Good for 10 people" << endl;
-        cout << "Table 10: Good for 10 people" << endl << endl;
-    }
-
-    void reserveTable(){
-        cout << "RESERVE TABLE AREA" << endl;
+    static inline atomic<bool> enabled{true};
+    static inline thread_local Cells *localCells = nullptr; // Constant-initialized: no TLS guard on the hot path
 
-        bool isReserved = false;
-        while (!isReserved){
-            system("cls");
-            viewAvailableAreas(); // display tables
+    mutex cellsMutex;
+    vector<unique_ptr<Cells>> allCells; // Kept after their thread exits so totals never go backwards
+    unsigned long long startTicks = metricTicks();
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
 
-            cout << "Enter table number (1-10): ";
-            int reservedTable;
-            cin >> reservedTable;
+    Metrics() {}
 
-            if (reservedTable < 1 || reservedTable > 10){ // validation for table
-                cout << "Invalid table number. Try again." << endl;
-                reservedTable = -1;
-                system("pause");
-            } else{
-                isReserved = true;
-                cout << "You have successfully reserved Table " << reservedTable << endl;
-            }
+    static Cells &threadCells(){
+        if (!localCells){
+            Metrics &metrics = instance();
+            lock_guard<mutex> lock(metrics.cellsMutex);
+            metrics.allCells.emplace_back(new Cells());
+            localCells = metrics.allCells.back().get();
         }
+        return *localCells;
     }
-    void inputCustomerDetails() override {}         // No input for TableArea, hence not needed here
-    void displayCustomerDetails() const override {} // No details to display for TableArea
-};
-
-class ReservationSystem{
-private:
-    static ReservationSystem *instance; // Static instance of the class
-    Customer customer;                  // To store customer details
-    Reservation reservation;            // To handle reservation slots
-    Menu menu;
-    TableArea tableArea;               // To handle table information
-    vector<pair<int, int>> menuOrders; // Stores menu item ID and quantity
-    vector<int> orders;                // Store ordered item IDs
-    vector<Customer> customers;
 
-    string reservationDate;
-    int reservationSlot = -1; // Initially, no slot selected
-    int reservedTable = -1;   // Initially, no table selected
-    bool reservationWithMenu = false;
+    static void bump(atomic<unsigned long long> &cell, unsigned long long amount){ // Single writer: no locked add needed
+        cell.store(cell.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
 
-    ReservationSystem() : tableArea(0, 0, true) {} // Private constructor to prevent instantiation
+    double ticksPerSecond(){
+#ifdef METRICS_RDTSC
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        while (seconds < 0.01){ // Too early to calibrate against the steady clock: wait a little
+            this_thread::sleep_for(chrono::milliseconds(10));
+            seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        }
+        return (metricTicks() - startTicks) / seconds;
+#else
+        return 1e9;
+#endif
+    }
 
 public:
-    // Delete copy constructor and assignment operator to prevent copies
-    ReservationSystem(const ReservationSystem &) = delete;
-    ReservationSystem &operator=(const ReservationSystem &) = delete;
+    static Metrics &instance(){
+        static Metrics metrics;
+        return metrics;
+    }
 
-    // Static method to get the instance of ReservationSystem
-    static ReservationSystem *getInstance(){
-        if (instance == nullptr){
-            instance = new ReservationSystem();
+    static bool isEnabled(){ return enabled.load(memory_order_relaxed); }
+    static void setEnabled(bool isOn){ enabled.store(isOn, memory_order_relaxed); }
+
+    static bool countCall(Metric metric){ // Counts the call; true if this one should be timed
+        if (!isEnabled()){
+            return false;
         }
-        return instance;
+        atomic<unsigned long long> &calls = threadCells().calls[metric];
+        unsigned long long count = calls.load(memory_order_relaxed);
+        calls.store(count + 1, memory_order_relaxed);
+        return (count & (METRICS_SAMPLE_EVERY - 1)) == 0;
     }
 
-    bool searchReservationByID(const string &id){
-        // First, check in memory
-        for (const auto &customer : customers){
-            if (customer.getCustomerID() == id){
-                customer.displayCustomerDetails(); // display customer details
-                return true;
+    unsigned long long totalCalls(){ // Every metric, every thread
+        unsigned long long total = 0;
+        lock_guard<mutex> lock(cellsMutex);
+        for (const auto &cells : allCells){
+            for (const auto &calls : cells->calls){
+                total += calls.load(memory_order_relaxed);
             }
         }
+        return total;
+    }
 
-        // Then, search in the file
-        ifstream file("customerss.txt"); // Correct file name
+    static void record(Metric metric, unsigned long long ticks){
+        Cells &cells = threadCells();
+        int bucket = min(max(bitLength(ticks) - 7, 0) / 2, bucketCount - 1);
+        bump(cells.ticks[metric], ticks);
+        bump(cells.buckets[metric][bucket], 1);
+    }
 
-        if (file.is_open()){
-            string line;
-            bool found = false;
+    string prometheusText(){ // Call counters and histograms in the Prometheus exposition format, bucket bounds in seconds
+        unsigned long long calls[metricCount] = {}, ticks[metricCount] = {}, buckets[metricCount][bucketCount] = {};
+        {
+            lock_guard<mutex> lock(cellsMutex);
+            for (const auto &cells : allCells){
+                for (int metric = 0; metric < metricCount; metric++){
+                    calls[metric] += cells->calls[metric].load(memory_order_relaxed);
+                    ticks[metric] += cells->ticks[metric].load(memory_order_relaxed);
+                    for (int bucket = 0; bucket < bucketCount; bucket++){
+                        buckets[metric][bucket] += cells->buckets[metric][bucket].load(memory_order_relaxed);
+                    }
+                }
+            }
+        }
 
-            while (getline(file, line)){
-                // Parse the line to extract the CustomerID
-                size_t pos = line.find("CustomerID: ");
-                if (pos != string::npos){
-                    size_t endPos = line.find(",", pos); // Find the end of the ID field
-                    string extractedID = line.substr(pos + 12, endPos - (pos + 12));
+        double secondsPerTick = 1 / ticksPerSecond();
+        ostringstream text;
+        text << setprecision(6);
+        for (int family = 0; family < 2; family++){
+            const char *counter = family ? "reservation_io_total" : "reservation_operations_total";
+            text << "# HELP " << counter << (family ? " Log and store file I/O calls.\n" : " Reservation operation calls.\n");
+            text << "# TYPE " << counter << " counter\n";
+            for (int metric = 0; metric < metricCount; metric++){
+                if (metricInfo[metric].isIO == (family == 1)){
+                    text << counter << "{operation=\"" << metricInfo[metric].operation << "\"} " << calls[metric] << "\n";
+                }
+            }
 
-                    // Compare extracted ID with the searched ID
-                    if (extractedID == id){
-                        found = true;
-                        cout << "Found in file: " << endl << line << endl;
-                        break; // Exit loop once the customer is found
+            const char *name = family ? "reservation_io_seconds" : "reservation_operation_seconds";
+            text << "# HELP " << name << (family ? " Time spent in log and store file I/O" : " Time spent in reservation operations")
+                 << ", sampled 1 in " << METRICS_SAMPLE_EVERY << " calls.\n";
+            text << "# TYPE " << name << " histogram\n";
+            for (int metric = 0; metric < metricCount; metric++){
+                if (metricInfo[metric].isIO != (family == 1)){
+                    continue;
+                }
+                string label = string("{operation=\"") + metricInfo[metric].operation + "\"";
+                unsigned long long cumulative = 0;
+                for (int bucket = 0; bucket < bucketCount; bucket++){
+                    cumulative += buckets[metric][bucket];
+                    text << name << "_bucket" << label << ",le=\"";
+                    if (bucket + 1 < bucketCount){
+                        text << (256.0 * (1ULL << (2 * bucket))) * secondsPerTick;
+                    } else{
+                        text << "+Inf";
                     }
+                    text << "\"} " << cumulative << "\n";
                 }
+                text << name << "_sum" << label << "} " << ticks[metric] * secondsPerTick << "\n";
+                text << name << "_count" << label << "} " << cumulative << "\n";
             }
-            file.close();
-            if (found){
-                return true;
-            }
-        } else{
-            cout << "Error: Unable to open the file for searching." << endl;
         }
-        cout << "Reservation ID " << id << " not found." << endl << endl;
-        return false;
+        return text.str();
     }
 
-    // Static method to get the single instance
-    void displayAllCustomers(){
-        if (customers.empty()){
-            cout << "No customers have made a reservation yet." << endl;
-        } else{
-            for (size_t i = 0; i < customers.size(); ++i){
-                cout << "Customer " << (i + 1) << " details:" << endl;
-                customers[i].displayCustomerDetails(); // Call Customer's displayCustomerDetails
+    bool writeFile(const string &fileName){ // Whole dump or nothing, for node_exporter's textfile collector
+        string temporary = fileName + ".tmp";
+        {
+            ofstream out(temporary, ios::binary);
+            out << prometheusText();
+            if (!out){
+                return false;
             }
         }
+#ifdef _WIN32
+        remove(fileName.c_str()); // rename does not replace on Windows
+#endif
+        return rename(temporary.c_str(), fileName.c_str()) == 0;
     }
+};
 
-    void displaySummary(){
-        cout << "\n--- Reservation Summary ---\n";
-        customer.displayCustomerDetails();
-
-        if (reservationSlot != -1){
-            cout << "Date: " << reservationDate << endl;
-            cout << "Time Slot: " << reservationSlot << " (" << 10 + 2 * (reservationSlot - 1)
-                 << ":00 - " << 12 + 2 * (reservationSlot - 1) << ":00)" << endl;
-        }
+class MetricTimer{ // Counts the enclosing scope and times the sampled calls
+private:
+    Metric metric;
+    unsigned long long start;
 
-        if (reservedTable != -1){
-            cout << "Reserved Table: " << reservedTable << endl;
+public:
+    explicit MetricTimer(Metric metric) : metric(metric), start(Metrics::countCall(metric) ? metricTicks() : 0) {}
+    MetricTimer(const MetricTimer &) = delete;
+    MetricTimer &operator=(const MetricTimer &) = delete;
+    ~MetricTimer(){
+        if (start){
+            Metrics::record(metric, metricTicks() - start);
         }
+    }
+};
 
-        if (reservationWithMenu && !menuOrders.empty()){
-            cout << endl << "Menu Order: " << endl;
-            cout << setw(10) << left << "ID"
-                 << setw(25) << left << "Name"
-                 << setw(10) << left << "Quantity" << endl;
+class MetricsFileWriter{ // Rewrites a metrics file every interval, and once more when stopped
+private:
+    string fileName;
+    chrono::seconds interval{10};
+    thread writer;
+    mutex stopMutex;
+    condition_variable stopSignal;
+    bool isStopping = false;
 
-            for (const auto &item : menuOrders){
-                cout << setw(10) << left << item.first
-                     << setw(25) << left << "Item " + to_string(item.first)
-                     << setw(10) << left << item.second << endl;
+public:
+    MetricsFileWriter(){ Metrics::instance(); } // Builds the registry first, so it outlives the final write
+    MetricsFileWriter(const MetricsFileWriter &) = delete;
+    MetricsFileWriter &operator=(const MetricsFileWriter &) = delete;
+
+    ~MetricsFileWriter(){
+        if (writer.joinable()){
+            {
+                lock_guard<mutex> lock(stopMutex);
+                isStopping = true;
             }
+            stopSignal.notify_all();
+            writer.join();
+            Metrics::instance().writeFile(fileName);
         }
-        cout << string(30, '-') << endl;
     }
 
-    void makeReservation(){
-        orders.clear(); // Clear orders for the new reservation
+    void start(const string &name, int seconds){
+        fileName = name;
+        interval = chrono::seconds(max(seconds, 1));
+        writer = thread([this](){
+            unique_lock<mutex> lock(stopMutex);
+            while (!stopSignal.wait_for(lock, interval, [this](){ return isStopping; })){
+                Metrics::instance().writeFile(fileName);
+            }
+        });
+    }
+};
 
-        Customer newCustomer;               // Create a new Customer object
-        newCustomer.inputCustomerDetails(); // Input details for the new customer
-        newCustomer.saveToFile();
-        customers.push_back(newCustomer); // Store the new customer in the customers vector
+#define METRIC_SCOPE(metric) MetricTimer metricScope(metric)
+#else
+#define METRIC_SCOPE(metric)
+#endif
 
-        system("cls");
+#ifdef COUNT_ALLOCATIONS // Opt-in: replaces the global operator new so --bench-sessions can count allocations
+thread_local unsigned long long threadAllocations = 0; // operator new calls made by this thread
 
-        // Handle reservation choice (Reservation only or Reservation + Food Order)
-        int reservationChoice;
-        bool validChoice = false;
+void *operator new(size_t size){ // Counts, then allocates as the library's would
+    threadAllocations++;
+    if (void *memory = malloc(size ? size : 1)){
+        return memory;
+    }
+    throw bad_alloc();
+}
 
-        while (!validChoice){
-            system("cls");
-            cout << "RESERVATION MENU" << endl;
-            cout << "1. Reservation Only" << endl;
-            cout << "2. Reservation + Food Order" << endl;
-            cout << endl << "Enter choice: ";
-            cin >> reservationChoice;
+#if defined(__GNUC__) || defined(__clang__)
+#define METRICS_NOINLINE __attribute__((noinline)) // Inlined into callers, GCC reports new/free as mismatched
+#else
+#define METRICS_NOINLINE
+#endif
+METRICS_NOINLINE void operator delete(void *memory) noexcept { free(memory); }
+METRICS_NOINLINE void operator delete(void *memory, size_t) noexcept { free(memory); }
+
+void *operator new(size_t size, align_val_t alignment){ // pmr::new_delete_resource allocates through this one
+    threadAllocations++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void *memory = aligned_alloc(align, (max(size, size_t(1)) + align - 1) / align * align)){
+        return memory;
+    }
+    throw bad_alloc();
+}
+METRICS_NOINLINE void operator delete(void *memory, align_val_t) noexcept { free(memory); }
+METRICS_NOINLINE void operator delete(void *memory, size_t, align_val_t) noexcept { free(memory); }
+#endif
+
+long long residentBytes(){ // Resident set size, 0 where it cannot be read
+#ifdef __linux__
+    long long pages = 0, resident = 0;
+    ifstream statm("/proc/self/statm");
+    if (statm >> pages >> resident){
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
 
-            if (reservationChoice == 1 || reservationChoice == 2){
-                validChoice = true;
-            } else{
-                cout << "Invalid input. Please enter 1 or 2 only." << endl;
-                system("pause");
+class SlotCalendar{ // One 64-bit occupancy word per day, grouped in 256-day blocks (2 KB per block)
+private:
+    static constexpr int daysPerBlock = 256;
+    static const int daysPerSpan = 7; // Week-long spans from the start of each block; the last one is 4 days
+    static const int spansPerBlock = (daysPerBlock + daysPerSpan - 1) / daysPerSpan;
+
+    struct Block{
+        atomic<unsigned long long> words[daysPerBlock];
+        atomic<unsigned long long> spanTaken[spansPerBlock]; // Bits set on every day of the span (AND of its words)
+        mutex spanMutex;                                     // Serialises span refreshes so the last one sees every word
+        Block(){
+            for (auto &word : words){
+                word.store(0, memory_order_relaxed);
             }
-        }
-
-        // Reserve date
-        string date;
-        bool isValidDate = false;
-
-        while (!isValidDate){
-            system("cls");
-            cout << "CHOOSE DATE" << endl << endl;
-            cout << "Enter reservation date (YYYY-MM-DD): ";
-            cin >> date;
-
-            // Validate the date format and check if it's available
-            if (isValidDateFormat(date)){
-                if (reservation.checkIfValidDate(date)){                       // Check if date is available
-                    isValidDate = true; // Exit loop if valid
-
-                    system("cls");
-                    cout << "CHOOSE TABLE" << endl << endl;
-                    tableArea.reserveTable(); // call function to reserve table
-
-                    // Reserve slot
-                    int slot;
-                    bool validSlot = false;
-
-                    while (!validSlot){
-                        system("cls");
-                        cout << "CHOOSE TIME" << endl << endl;
-                        reservation.checkAvailability(date); // Check if date is available or not
-
-                        cout << endl << "Enter slot number (1-5): ";
-                        cin >> slot;
-
-                        if (slot < 1 || slot > 5){ // validation for time slot
-                            cout << "Invalid input. Please enter a number between 1 to 5 only." << endl << endl;
-                            system("pause");
-                        } else if (!reservation.reserveSlot(date, slot - 1)){
-                            cout << "Unable to reserve slot. Please try again." << endl << endl;
-                            system("pause");
-                            return;
-                        } else{
-                            validSlot = true;
-                            system("pause");
-                        }
-                    }
-                } else{
-                    cout << "The entered date is not available for reservation. Try another date." << endl << endl;
-                    system("pause");
-                }
-            } else{
-                cout << "Invalid date format or the date is in the past. Please follow the format (YYYY-MM-DD)." << endl << endl;
-                system("pause");
+            for (auto &span : spanTaken){
+                span.store(0, memory_order_relaxed);
             }
         }
+    };
 
-        if (reservationChoice == 2){ // display all menu at once
-            system("cls");
-            cout << "RESTAURANT MENU" << endl << endl;
-
-            Menu appetizer("PAMAWING-GUTOM");
-            appetizer.displayMenu();
-            cout << endl;
+    map<int, unique_ptr<Block>> blocks; // Key: day number / 256; blocks are never removed, so pointers stay valid
+    mutable shared_mutex blocksMutex;   // Guards the map only, the words themselves are updated with CAS
 
-            Menu mainCourse("PANGUNAHING PAGKAIN");
-            mainCourse.displayMenu();
-            cout << endl;
+    static int blockOf(int dayNumber){ // Floor division so days before 1970 land in the right block
+        return dayNumber >= 0 ? dayNumber / daysPerBlock : -((-dayNumber + daysPerBlock - 1) / daysPerBlock);
+    }
 
-            Menu dessert("PANGHIMAGAS");
-            dessert.displayMenu();
-            cout << endl;
+    static int offsetOf(int dayNumber){
+        return dayNumber - blockOf(dayNumber) * daysPerBlock;
+    }
 
-            Menu beverage("PANULAK");
-            beverage.displayMenu();
-            cout << endl;
+    Block *findBlock(int dayNumber) const{
+        shared_lock<shared_mutex> lock(blocksMutex);
+        auto it = blocks.find(blockOf(dayNumber));
+        return it == blocks.end() ? nullptr : it->second.get();
+    }
 
-            ReservationSystem::getInstance()->menuOrder(); // allow customer to order from menu
+    Block *findOrCreateBlock(int dayNumber){
+        Block *block = findBlock(dayNumber);
+        if (block){
+            return block;
+        }
+        unique_lock<shared_mutex> lock(blocksMutex);
+        unique_ptr<Block> &slot = blocks[blockOf(dayNumber)];
+        if (!slot){ // Another thread may have created it between the two locks
+            slot.reset(new Block());
         }
+        return slot.get();
     }
 
-    void menuOrder(){ // function to allow customer to order from menu
-        char continueOrdering = 'Y';
-        reservationWithMenu = false;
+    static void refreshSpan(Block *block, int offset){ // Recomputes the summary of the span holding offset after a word changed
+        lock_guard<mutex> lock(block->spanMutex);
+        int first = offset / daysPerSpan * daysPerSpan;
+        int last = min(first + daysPerSpan, daysPerBlock);
+        unsigned long long taken = ~0ULL;
+        for (int i = first; i < last; i++){
+            taken &= block->words[i].load(memory_order_acquire);
+        }
+        block->spanTaken[offset / daysPerSpan].store(taken, memory_order_release);
+    }
 
-        while (continueOrdering == 'Y'){
-            cout << "What would you like to order?" << endl;
-            cout << "Enter Menu ID: ";
-            int orderItemID;
-            cin >> orderItemID;
+public:
+    unsigned long long getDay(int dayNumber) const{ // Read-only: unseen days are simply 0
+        Block *block = findBlock(dayNumber);
+        return block ? block->words[offsetOf(dayNumber)].load(memory_order_acquire) : 0;
+    }
 
-            if (cin.fail()){
-                cin.clear();                                         // Clear the error flag
-                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore invalid input
-                cout << "Invalid input. Please enter a valid Menu ID." << endl;
-                continue;
+    bool reserveBits(int dayNumber, unsigned long long bits){ // Atomically sets bits only if none of them is already set
+        Block *block = findOrCreateBlock(dayNumber);
+        atomic<unsigned long long> &word = block->words[offsetOf(dayNumber)];
+        unsigned long long current = word.load(memory_order_acquire);
+        do {
+            if (current & bits){
+                return false;
             }
+        } while (!word.compare_exchange_weak(current, current | bits, memory_order_acq_rel, memory_order_acquire));
+        refreshSpan(block, offsetOf(dayNumber));
+        return true;
+    }
 
-            const vector<int> &menuIDs = menu.getMenuIDs();
+    void releaseBits(int dayNumber, unsigned long long bits){
+        Block *block = findBlock(dayNumber);
+        if (block){
+            block->words[offsetOf(dayNumber)].fetch_and(~bits, memory_order_acq_rel);
+            refreshSpan(block, offsetOf(dayNumber));
+        }
+    }
 
-            if (orderItemID >= 0 && orderItemID < 20 && std::find(menuIDs.begin(), menuIDs.end(), orderItemID) == menuIDs.end()){
-                orders.push_back(orderItemID); // Add the item to the orders list
-                reservationWithMenu = true;
-                cout << "Order added successfully!" << endl;
-            } else{
-                cout << "Invalid Menu ID. Try again." << endl;
+    // Visits the days of [fromDay, fromDay + numDays) in order under one shared lock, without allocating.
+    // skipSpan(taken) gets the bits set on every day of a week-long span; when it returns true no day of the
+    // span can match and its days are passed over unvisited. visit(day, word) returns false to stop.
+    template <class SkipSpan, class Visit>
+    void scanDays(int fromDay, int numDays, SkipSpan skipSpan, Visit visit) const{
+        shared_lock<shared_mutex> lock(blocksMutex);
+        int day = fromDay;
+        int endDay = fromDay + numDays;
+        while (day < endDay){
+            int blockKey = blockOf(day);
+            int base = blockKey * daysPerBlock;
+            int blockEnd = min(endDay, base + daysPerBlock);
+            auto it = blocks.find(blockKey);
+            if (it == blocks.end()){ // Never booked: every day is free
+                for (; day < blockEnd; day++){
+                    if (!visit(day, 0ULL)){
+                        return;
+                    }
+                }
+                continue;
             }
 
-            cout << endl << "Would you like to order another item? (Y/N): ";
-            cin >> continueOrdering;
-            continueOrdering = toupper(continueOrdering);
-            cout << endl;
-
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            const Block &block = *it->second;
+            while (day < blockEnd){
+                int span = (day - base) / daysPerSpan;
+                int spanEnd = min(blockEnd, base + (span + 1) * daysPerSpan);
+                if (skipSpan(block.spanTaken[span].load(memory_order_acquire))){
+                    day = spanEnd;
+                    continue;
+                }
+                for (; day < spanEnd; day++){
+                    if (!visit(day, block.words[day - base].load(memory_order_acquire))){
+                        return;
+                    }
+                }
+            }
         }
-        cout << "Your Order Summary: " << endl;
-        for (int id : orders){
-            cout << "- Item ID: " << id << endl;
+    }
+
+    // Scans numDays days from fromDay for the first clear bit within mask, using a bit scan per day
+    bool findFirstFree(int fromDay, int numDays, unsigned long long mask, int &dayOut, int &bitOut) const{
+        for (int day = fromDay; day < fromDay + numDays; day++){
+            unsigned long long freeBits = ~getDay(day) & mask;
+            if (freeBits){
+                dayOut = day;
+                bitOut = lowestSetBit(freeBits);
+                return true;
+            }
         }
-        cout << endl;
-        system("pause");
+        return false;
     }
+};
 
-    void viewMenu() {
-    bool continueViewing = true;
+class ShardedIDSet{ // Set of customer IDs split across independently locked shards
+private:
+    static const int shardCount = 16;
 
-    while (continueViewing) {
-        string category;
-        system("cls");
+    struct Shard{
+        mutex shardMutex;
+        unordered_set<string> ids;
+    };
 
-        cout << "VIEW MENU" << endl;
-        cout << endl << "Select a menu category:" << endl;
-        cout << "1. PAMAWING-GUTOM" << endl;
-        cout << "2. PANGUNAHING PAGKAIN" << endl;
-        cout << "3. PANGHIMAGAS" << endl;
-        cout << "4. PANULAK" << endl;
-        cout << endl << "Enter your choice: ";
+    Shard shards[shardCount];
 
-        int menuChoice;
-        cin >> menuChoice;
+    Shard &shardFor(const string &id){
+        return shards[hash<string>()(id) % shardCount];
+    }
 
-        switch (menuChoice) {
-        case 1:
-            category = "PAMAWING-GUTOM";
-            break;
-        case 2:
-            category = "PANGUNAHING PAGKAIN";
-            break;
-        case 3:
-            category = "PANGHIMAGAS";
-            break;
-        case 4:
-            category = "PANULAK";
-            break;
-        default:
-            cout << "Invalid choice. Try again." << endl << endl;
-            system("pause");
-            continue; // Restart the loop for valid input
-        }
+public:
+    bool insert(const string &id){ // True if the ID was not there yet; check and insert happen under one lock
+        Shard &shard = shardFor(id);
+        lock_guard<mutex> lock(shard.shardMutex);
+        return shard.ids.insert(id).second;
+    }
 
-        Menu categoryMenu(category);
-        system("cls");
-        cout << "MENU: " << category << endl;
-        cout << "--------------------------------" << endl;
-        categoryMenu.displayMenu();
-        cout << endl;
+    void erase(const string &id){
+        Shard &shard = shardFor(id);
+        lock_guard<mutex> lock(shard.shardMutex);
+        shard.ids.erase(id);
+    }
 
-        bool validInput = false;
+    bool contains(const string &id){
+        Shard &shard = shardFor(id);
+        lock_guard<mutex> lock(shard.shardMutex);
+        return shard.ids.count(id) > 0;
+    }
+};
 
-        while (!validInput) {
-            cout << "Would you like to view other menu categories? (Y/N): ";
-            char viewMenuChoice;
-            cin >> viewMenuChoice;
-            viewMenuChoice = toupper(viewMenuChoice);
+class ShardedFirstRow{ // Customer ID -> earliest row offering it, with that row's details and their hash; shards locked independently
+private:
+    static const int shardCount = 64;
 
-            if (viewMenuChoice == 'Y') {
-                validInput = true; // Exit validation loop
-            } else if (viewMenuChoice == 'N') {
-                validInput = true;       // Exit validation loop
-                continueViewing = false; // Exit outer loop
-            } else {
-                cout << "Invalid input. Please enter 'Y' or 'N' only." << endl << endl;
-                system("pause");
-                system("cls");
-                cout << "MENU: " << category << endl;
-                cout << "--------------------------------" << endl;
-                categoryMenu.displayMenu();
-                cout << endl;
-            }
-        }
-    }
-}
-    bool isPaid = false;
+    struct FirstRow{
+        long long row;
+        unsigned int detailsHash;
+        string details;
+    };
 
-    void updateReservation(){
-        system("cls");
-        cout << "UPDATE RESERVATION" << endl;
-        cout << "1. Change date and time" << endl;
-        cout << "2. Change table" << endl;
-        cout << "3. Add to order" << endl;
-        cout << "4. Proceed to payment" << endl;
-        cout << "5. Cancel reservation" << endl; // Correct numbering
-        cout << "\nEnter choice: ";
-        int updateChoice;
-        cin >> updateChoice;
+    struct Shard{
+        mutex shardMutex;
+        unordered_map<string, FirstRow> rows;
+    };
 
-        switch (updateChoice){
-        case 1:
-            system("cls");
-            cout << "CHANGE DATE AND TIME" << endl << endl;
-            cout << "Enter new reservation date (YYYY-MM-DD): ";
-            cin >> reservationDate;
+    Shard shards[shardCount];
 
-            cout << "Enter new slot number (1-5): ";
-            cin >> reservationSlot;
+    Shard &shardFor(const string &id){
+        return shards[hash<string>()(id) % shardCount];
+    }
 
+public:
+    // Keeps the smallest row, whatever order threads arrive in; details() is only built for a row that is kept
+    template <typename MakeDetails>
+    void offer(const string &id, long long row, unsigned int detailsHash, MakeDetails details){
+        Shard &shard = shardFor(id);
+        lock_guard<mutex> lock(shard.shardMutex);
+        auto inserted = shard.rows.emplace(id, FirstRow{row, detailsHash, string()});
+        if (inserted.second || row < inserted.first->second.row){
+            inserted.first->second = FirstRow{row, detailsHash, details()};
+        }
+    }
 
-            if (!reservation.reserveSlot(reservationDate, reservationSlot - 1)){
-                cout << "Unable to reserve the new slot.\n";
+    // True if an earlier row offered the ID with other details. Different hashes settle it; equal hashes are
+    // confirmed on the details themselves, so a hash collision cannot pass two customers off as one.
+    template <typename SameDetails>
+    bool differsFromFirst(const string &id, long long row, unsigned int detailsHash, SameDetails isSame){
+        Shard &shard = shardFor(id);
+        lock_guard<mutex> lock(shard.shardMutex);
+        auto found = shard.rows.find(id);
+        if (found == shard.rows.end() || found->second.row == row){
+            return false;
+        }
+        return found->second.detailsHash != detailsHash || !isSame(found->second.details);
+    }
+};
+
+// Fixed set of worker threads plus the calling thread. parallelFor deals a range out in chunks, a contiguous
+// run per worker; a worker that runs dry steals from the back of another worker's queue.
+class WorkStealingPool{
+private:
+    struct WorkQueue{
+        mutex queueMutex;
+        deque<pair<size_t, size_t>> chunks; // [begin, end) ranges
+    };
+
+    vector<thread> workers;
+    vector<unique_ptr<WorkQueue>> queues; // queues[0] belongs to the calling thread
+    mutex poolMutex;
+    condition_variable wakeWorkers, workDone;
+    function<void(size_t, size_t)> job;
+    size_t generation = 0;
+    int busyWorkers = 0;
+    bool isStopping = false;
+
+    bool takeChunk(size_t self, pair<size_t, size_t> &chunk){
+        {
+            WorkQueue &own = *queues[self];
+            lock_guard<mutex> lock(own.queueMutex);
+            if (!own.chunks.empty()){
+                chunk = own.chunks.front();
+                own.chunks.pop_front();
+                return true;
             }
-            break;
+        }
+        for (size_t i = 1; i < queues.size(); i++){
+            WorkQueue &victim = *queues[(self + i) % queues.size()];
+            lock_guard<mutex> lock(victim.queueMutex);
+            if (!victim.chunks.empty()){
+                chunk = victim.chunks.back();
+                victim.chunks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
 
-        case 2:
-            system("cls");
-            cout << "CHANGE TABLE" << endl << endl;
-            tableArea.reserveTable();
-            break;
+    void runChunks(size_t self){
+        pair<size_t, size_t> chunk;
+        while (takeChunk(self, chunk)){
+            job(chunk.first, chunk.second);
+        }
+    }
 
-        case 3:
-            system("cls");
-            cout << "CHANGE ORDER" << endl << endl;
-            if (reservationWithMenu){
-                cout << "RESTAURANT MENU" << endl << endl;
-                Menu appetizer("PAMAWING-GUTOM");
-                appetizer.displayMenu();
-                cout << endl;
+    void workerLoop(size_t self){
+        size_t seenGeneration = 0;
+        while (true){
+            {
+                unique_lock<mutex> lock(poolMutex);
+                wakeWorkers.wait(lock, [&](){ return isStopping || generation != seenGeneration; });
+                if (isStopping){
+                    return;
+                }
+                seenGeneration = generation;
+            }
+            runChunks(self);
+            {
+                lock_guard<mutex> lock(poolMutex);
+                if (--busyWorkers == 0){
+                    workDone.notify_one();
+                }
+            }
+        }
+    }
 
-                Menu mainCourse("PANGUNAHING PAGKAIN");
-                mainCourse.displayMenu();
-                cout << endl;
+public:
+    explicit WorkStealingPool(int threadCount){
+        threadCount = max(threadCount, 1);
+        for (int i = 0; i < threadCount; i++){
+            queues.emplace_back(new WorkQueue());
+        }
+        for (int i = 1; i < threadCount; i++){
+            workers.emplace_back([this, i](){ workerLoop(static_cast<size_t>(i)); });
+        }
+    }
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
 
-                Menu dessert("PANGHIMAGAS");
-                dessert.displayMenu();
-                cout << endl;
+    ~WorkStealingPool(){
+        {
+            lock_guard<mutex> lock(poolMutex);
+            isStopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (thread &worker : workers){
+            worker.join();
+        }
+    }
 
-                Menu beverage("PANULAK");
-                beverage.displayMenu();
-                cout << endl;
+    int size() const { return static_cast<int>(queues.size()); }
 
-                menuOrder();
-            }else{
-                cout << "Menu was not selected initially." << endl;
-            }
-            break;
+    void parallelFor(size_t count, size_t grain, const function<void(size_t, size_t)> &body){ // Returns once body has covered [0, count)
+        size_t chunkCount = (count + grain - 1) / grain;
+        for (size_t i = 0; i < chunkCount; i++){
+            WorkQueue &queue = *queues[i * queues.size() / chunkCount];
+            lock_guard<mutex> lock(queue.queueMutex);
+            queue.chunks.push_back(make_pair(i * grain, min(count, (i + 1) * grain)));
+        }
 
-        case 4:
-            system("cls");
-            cout << "PROCEED TO PAYMENT" << endl << endl;
+        {
+            lock_guard<mutex> lock(poolMutex);
+            job = body;
+            busyWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        wakeWorkers.notify_all();
+        runChunks(0);
 
-            // Check if the payment has already been made
-            if (isPaid){
-                cout << "Payment is already completed. Returning to the main menu.\n";
-                break;
-            }
+        unique_lock<mutex> lock(poolMutex);
+        workDone.wait(lock, [&](){ return busyWorkers == 0; });
+    }
+};
 
-            int paymentChoice;
-            cout << "Select payment method:\n";
-            cout << "1. Credit Card\n";
-            cout << "2. Online Payment\n";
-            cout << endl << "Enter choice: ";
-            cin >> paymentChoice;
+// Bounded lock-free ring: any number of producers, one consumer at a time. Each cell's sequence number says
+// whether it is ready for the next producer (== position) or holds a value for the consumer (== position + 1).
+template <typename T, size_t Capacity>
+class MpscRing{
+private:
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
 
-            if (paymentChoice == 1 || paymentChoice == 2){
-                float amount = reservationWithMenu ? 1500.0 : 500.0;
-                cout << endl << "Amount due: P" << amount << endl;
+    struct Cell{
+        atomic<size_t> sequence;
+        T value;
+    };
 
-                if (paymentChoice == 1){
-                    string cardNumber;
-                    cout << "Enter credit card number: ";
-                    cin.ignore();
-                    getline(cin, cardNumber);
+    unique_ptr<Cell[]> cells;
+    alignas(64) atomic<size_t> enqueuePosition; // Shared by producers
+    alignas(64) size_t dequeuePosition = 0;     // Consumer only
 
-                    if (cardNumber.length() >= 13 && cardNumber.length() <= 19){
-                        cout << "Payment successful using Credit Card!" << endl;
-                        isPaid = true; // Mark payment as completed
-                    } else{
-                        cout << "Invalid credit card number. Payment failed." << endl;
-                    }
-                } else if (paymentChoice == 2){
-                    string onlinePaymentID;
-                    cout << "Enter Online Payment Transaction ID: ";
-                    cin.ignore();
-                    getline(cin, onlinePaymentID);
-
-                    if (!onlinePaymentID.empty()){
-                        cout << "Payment successful using Online Payment!" << endl;
-                        isPaid = true; // Mark payment as completed
-                    } else{
-                        cout << "Invalid Transaction ID. Payment failed." << endl;
-                    }
+public:
+    MpscRing() : cells(new Cell[Capacity]), enqueuePosition(0){
+        for (size_t i = 0; i < Capacity; i++){
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    bool tryPush(const T &value){ // False if the ring is full
+        size_t position = enqueuePosition.load(memory_order_relaxed);
+        while (true){
+            Cell &cell = cells[position & (Capacity - 1)];
+            ptrdiff_t lag = static_cast<ptrdiff_t>(cell.sequence.load(memory_order_acquire) - position);
+            if (lag == 0){
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)){
+                    cell.value = value;
+                    cell.sequence.store(position + 1, memory_order_release);
+                    return true;
                 }
+            } else if (lag < 0){
+                return false; // The consumer has not freed this cell yet
             } else{
-                cout << "Invalid payment method selected." << endl;
+                position = enqueuePosition.load(memory_order_relaxed); // Another producer took it
             }
-            break;
-
-        case 5:
-            system("cls");
-            cout << "CANCEL RESERVATION" << endl << endl;
-            reservationDate.clear();
-            reservationSlot = -1;
-            reservedTable = -1;
-            menuOrders.clear();
-            reservationWithMenu = false;
-            isPaid = false; // Reset payment status
-            cout << "Your reservation has been cancelled." << endl;
-            break;
-
-        default:
-            cout << "Invalid choice." << endl;
-            break;
         }
     }
 
-    void viewReservationSummary(){
-        customer.displayCustomerDetails();
-        displaySummary();
-        updateReservation();
+    bool tryPop(T &value){ // Consumer only; false if the ring is empty
+        Cell &cell = cells[dequeuePosition & (Capacity - 1)];
+        if (cell.sequence.load(memory_order_acquire) != dequeuePosition + 1){
+            return false;
+        }
+        value = cell.value;
+        cell.sequence.store(dequeuePosition + Capacity, memory_order_release);
+        dequeuePosition++;
+        return true;
     }
 };
 
-ReservationSystem *ReservationSystem::instance = nullptr; // Initialize static member
-
-int main(){
-    Reservation reservation; // Non-singleton
-    Customer customer;       // Non-singleton
-    Menu menu;
-    TableArea tableArea(0, 0, true); // Non-singleton
+bool seekFile(FILE *file, long long offset){ // fseek with 64-bit offsets on every platform
+#ifdef _WIN32
+    return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+bool syncFile(FILE *file){ // Pushes buffered data to the OS, then forces it to disk
+    if (fflush(file) != 0){
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+class MappedFile{ // Read-only view of a whole file: mmap on POSIX, MapViewOfFile on Windows
+private:
+    const char *view = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() { unmap(); }
+
+    bool map(const string &fileName){
+        unmap();
+#ifdef _WIN32
+        fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE){
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(fileHandle, &fileSize);
+        length = static_cast<size_t>(fileSize.QuadPart);
+        if (length > 0){
+            mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            view = mappingHandle ? static_cast<const char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        }
+#else
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0){
+            return false;
+        }
+
+        struct stat fileInfo;
+        length = fstat(fd, &fileInfo) == 0 ? static_cast<size_t>(fileInfo.st_size) : 0;
+        if (length > 0){
+            void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            view = address == MAP_FAILED ? nullptr : static_cast<const char *>(address);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed
+#endif
+        if (length > 0 && view == nullptr){
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void unmap(){
+#ifdef _WIN32
+        if (view){
+            UnmapViewOfFile(view);
+        }
+        if (mappingHandle){
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle != INVALID_HANDLE_VALUE){
+            CloseHandle(fileHandle);
+        }
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (view){
+            munmap(const_cast<char *>(view), length);
+        }
+#endif
+        view = nullptr;
+        length = 0;
+    }
+
+    const char *data() const { return view; }
+    size_t size() const { return length; }
+};
+
+// Fixed-size records for the binary stores; text fields are NUL-padded and truncated to fit
+struct CustomerRecord{
+    char customerID[32];
+    char customerName[64];
+    char contactNumber[16];
+    char customerEmail[64];
+};
+
+struct BookingRecord{
+    char customerID[32];
+    int dayNumber;
+    int slot;   // 0-based
+    int table;      // 1-based first table, -1 if none
+    int tableCount; // Adjacent tables joined from table on, 1 for a single table
+    int status;     // BookingStatus
+};
+
+struct OrderRecord{
+    char customerID[32];
+    int menuID;
+    int quantity; // Negative for the reversal logged when the booking is cancelled
+};
+
+enum BookingStatus { BookingActive = 0, BookingCancelled = 1, BookingPaid = 2 };
+
+template <size_t N>
+void copyField(char (&field)[N], const string &value){
+    memset(field, 0, N);
+    memcpy(field, value.data(), min(value.size(), N - 1)); // Always leaves a terminating NUL
+}
+
+template <size_t N>
+string fieldToString(const char (&field)[N]){
+    return string(field, strnlen(field, N));
+}
+
+template <typename Record>
+class RecordStore{ // Append-only file of fixed-size records; reads come straight from the mapping
+private:
+    struct FileHeader{
+        char magic[4];                // "SSRS"
+        unsigned int version;
+        unsigned int recordSize;
+        unsigned int appliedSequence; // Last log sequence written into this store
+    };
+
+    string fileName;
+    FILE *file = nullptr; // Kept open for appends and in-place updates
+    MappedFile mapping;   // Remapped lazily once appends outgrow it
+    size_t recordCount = 0;
+    unsigned int lastSequence = 0;
+
+    bool remap(){
+        METRIC_SCOPE(MetricStoreRemap);
+        return mapping.map(fileName) && mapping.size() >= sizeof(FileHeader);
+    }
+
+    bool writeAt(long long offset, const void *bytes, size_t length){
+        return seekFile(file, offset) && fwrite(bytes, length, 1, file) == 1;
+    }
+
+    bool markApplied(unsigned int sequence){ // Writes the new watermark after the record it covers
+        lastSequence = max(lastSequence, sequence);
+        return writeAt(offsetof(FileHeader, appliedSequence), &lastSequence, sizeof(lastSequence)) && fflush(file) == 0;
+    }
+
+public:
+    explicit RecordStore(const string &fileName) : fileName(fileName) {}
+    RecordStore(const RecordStore &) = delete;
+    RecordStore &operator=(const RecordStore &) = delete;
+
+    ~RecordStore(){
+        if (file){
+            fclose(file);
+        }
+    }
+
+    bool open(){ // Creates the file with a header if missing, then maps it
+        ifstream probe(fileName, ios::binary);
+        if (!probe.is_open()){
+            ofstream create(fileName, ios::binary);
+            FileHeader header = {{'S', 'S', 'R', 'S'}, 1, sizeof(Record), 0};
+            create.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        }
+        probe.close();
+
+        if (!remap()){
+            return false;
+        }
+
+        const FileHeader *header = reinterpret_cast<const FileHeader *>(mapping.data());
+        if (memcmp(header->magic, "SSRS", 4) != 0 || header->recordSize != sizeof(Record)){
+            return false; // Not a store file, or written with a different record layout
+        }
+
+        recordCount = (mapping.size() - sizeof(FileHeader)) / sizeof(Record);
+        lastSequence = header->appliedSequence;
+        file = fopen(fileName.c_str(), "r+b");
+        return file != nullptr;
+    }
+
+    size_t size() const { return recordCount; }
+    unsigned int appliedSequence() const { return lastSequence; }
+
+    // Zero-copy access to record index; the reference is valid until the next append
+    const Record &at(size_t index){
+        if (sizeof(FileHeader) + (index + 1) * sizeof(Record) > mapping.size()){
+            fflush(file);
+            remap();
+        }
+        return reinterpret_cast<const Record *>(mapping.data() + sizeof(FileHeader))[index];
+    }
+
+    long long append(const Record &record, unsigned int sequence){ // Returns the new record's index, or -1 on failure
+        METRIC_SCOPE(MetricStoreAppend);
+        if (!writeAt(sizeof(FileHeader) + recordCount * sizeof(Record), &record, sizeof(Record)) || !markApplied(sequence)){
+            return -1;
+        }
+        return static_cast<long long>(recordCount++);
+    }
+
+    bool update(size_t index, const Record &record, unsigned int sequence){ // Overwrites record index in place
+        METRIC_SCOPE(MetricStoreUpdate);
+        if (index >= recordCount){
+            return false;
+        }
+        return writeAt(sizeof(FileHeader) + index * sizeof(Record), &record, sizeof(Record)) && markApplied(sequence);
+    }
+
+    bool sync(){
+        return syncFile(file);
+    }
+};
+
+enum LogEventType { LogCustomer = 1, LogBooking, LogTableChange, LogOrder, LogPayment, LogCancel, LogMove };
+
+struct LogRecord{ // One write-ahead log entry; fields the event type does not use stay zero
+    unsigned int sequence;
+    int type;            // LogEventType
+    int bookingIndex;    // Booking the event refers to (table change, payment, cancel, move)
+    int dayNumber;
+    int slot;
+    int table;
+    int menuID;
+    int quantity;        // Order quantity, or the number of joined tables for booking and table change events
+    int paymentMethod;
+    CustomerRecord customer; // customer.customerID names the customer for every event type
+    unsigned int checksum;   // Over everything above, so a torn write at the tail is detected
+};
+
+unsigned int checksumOf(const LogRecord &event){ // FNV-1a
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&event);
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(LogRecord, checksum); i++){
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+enum FsyncPolicy { FsyncAlways, FsyncGroup, FsyncNone };
+
+class WriteAheadLog{ // Append-only event log; with FsyncGroup one fsync covers a whole batch of commits
+private:
+    static const int groupSize = 64;       // Sync once this many commits are waiting...
+    static constexpr int groupWindowMs = 20;   // ...or once the oldest waiting commit is this old
+
+    string fileName;
+    FILE *file = nullptr;
+    FsyncPolicy policy = FsyncGroup;
+    int pendingRecords = 0;
+    size_t recordCount = 0;
+    chrono::steady_clock::time_point firstPending;
+
+public:
+    explicit WriteAheadLog(const string &fileName) : fileName(fileName) {}
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    ~WriteAheadLog(){
+        if (file){
+            sync();
+            fclose(file);
+        }
+    }
+
+    void setPolicy(FsyncPolicy newPolicy){ policy = newPolicy; }
+    size_t size() const { return recordCount; }
+
+    vector<LogRecord> readAll() const{ // Stops at the first incomplete or corrupt record
+        vector<LogRecord> events;
+        ifstream inFile(fileName, ios::binary);
+        LogRecord event;
+        while (inFile.read(reinterpret_cast<char *>(&event), sizeof(event)) && event.checksum == checksumOf(event)){
+            events.push_back(event);
+        }
+        return events;
+    }
+
+    bool open(){
+        if (file){ // The startup checkpoint's truncate leaves a handle open
+            fclose(file);
+        }
+        file = fopen(fileName.c_str(), "ab");
+        recordCount = readAll().size();
+        return file != nullptr;
+    }
+
+    bool append(LogRecord &event){
+        METRIC_SCOPE(MetricLogAppend);
+        event.checksum = checksumOf(event);
+        if (fwrite(&event, sizeof(event), 1, file) != 1){
+            return false;
+        }
+        recordCount++;
+
+        if (pendingRecords++ == 0){
+            firstPending = chrono::steady_clock::now();
+        }
+        if (policy == FsyncAlways || (policy == FsyncGroup && (pendingRecords >= groupSize ||
+            chrono::steady_clock::now() - firstPending >= chrono::milliseconds(groupWindowMs)))){
+            return sync();
+        }
+        return true;
+    }
+
+    bool sync(){ // Group commit point: everything appended so far becomes durable
+        METRIC_SCOPE(MetricLogSync);
+        if (pendingRecords == 0){
+            return true;
+        }
+        pendingRecords = 0;
+        return policy == FsyncNone ? fflush(file) == 0 : syncFile(file);
+    }
+
+    bool truncate(){ // Only after every logged event is safely in the stores
+        if (file){
+            fclose(file);
+        }
+        file = fopen(fileName.c_str(), "wb");
+        pendingRecords = 0;
+        recordCount = 0;
+        return file != nullptr;
+    }
+};
+
+class ReservationStore{ // Binary stores plus the write-ahead log in front of them
+private:
+    static const size_t checkpointSize = 4096; // Log records kept before they are folded into the stores
+
+    WriteAheadLog log;
+    unsigned int lastSequence = 0;
+    mutex storeMutex; // One writer at a time for the log and the stores
+
+    bool checkpointLocked(){
+        METRIC_SCOPE(MetricCheckpoint);
+        return log.sync() && customers.sync() && bookings.sync() && orders.sync() && log.truncate();
+    }
+
+    long long apply(const LogRecord &event){ // Applies one event to its store; skips events the store already has
+        switch (event.type){
+        case LogCustomer:
+            if (event.sequence <= customers.appliedSequence()){
+                return -1;
+            }
+            return customers.append(event.customer, event.sequence);
+
+        case LogBooking:{
+            if (event.sequence <= bookings.appliedSequence()){
+                return -1;
+            }
+            BookingRecord booking;
+            memcpy(booking.customerID, event.customer.customerID, sizeof(booking.customerID));
+            booking.dayNumber = event.dayNumber;
+            booking.slot = event.slot;
+            booking.table = event.table;
+            booking.tableCount = max(event.quantity, 1);
+            booking.status = BookingActive;
+            return bookings.append(booking, event.sequence);
+        }
+
+        case LogTableChange:
+        case LogPayment:
+        case LogCancel:
+        case LogMove:{
+            if (event.sequence <= bookings.appliedSequence() || event.bookingIndex < 0 || static_cast<size_t>(event.bookingIndex) >= bookings.size()){
+                return -1;
+            }
+            BookingRecord booking = bookings.at(event.bookingIndex);
+            if (event.type == LogTableChange){
+                booking.table = event.table;
+                booking.tableCount = max(event.quantity, 1);
+            } else if (event.type == LogMove){ // New date, slot and tables in one record
+                booking.dayNumber = event.dayNumber;
+                booking.slot = event.slot;
+                booking.table = event.table;
+                booking.tableCount = max(event.quantity, 1);
+            } else if (event.type == LogPayment){
+                booking.status = BookingPaid;
+            } else{
+                booking.status = BookingCancelled;
+            }
+            return bookings.update(event.bookingIndex, booking, event.sequence) ? event.bookingIndex : -1;
+        }
+
+        case LogOrder:{
+            if (event.sequence <= orders.appliedSequence()){
+                return -1;
+            }
+            OrderRecord order;
+            memcpy(order.customerID, event.customer.customerID, sizeof(order.customerID));
+            order.menuID = event.menuID;
+            order.quantity = event.quantity;
+            return orders.append(order, event.sequence);
+        }
+        }
+        return -1;
+    }
+
+public:
+    RecordStore<CustomerRecord> customers; // customers.dat
+    RecordStore<BookingRecord> bookings;   // bookings.dat
+    RecordStore<OrderRecord> orders;       // orders.dat
+
+    explicit ReservationStore(const string &prefix = "") // prefix lets a stress run keep its files apart
+        : log(prefix + "reservations.wal"), customers(prefix + "customers.dat"), bookings(prefix + "bookings.dat"), orders(prefix + "orders.dat") {}
+
+    bool open(){ // Maps the stores, then replays whatever the log holds beyond them
+        if (!customers.open() || !bookings.open() || !orders.open()){
+            return false;
+        }
+        lastSequence = max(customers.appliedSequence(), max(bookings.appliedSequence(), orders.appliedSequence()));
+
+        for (const LogRecord &event : log.readAll()){
+            apply(event);
+            lastSequence = max(lastSequence, event.sequence);
+        }
+        return checkpoint() && log.open(); // Runs before any other thread can see the store
+    }
+
+    void setFsyncPolicy(FsyncPolicy policy){ log.setPolicy(policy); }
+
+    long long commit(LogRecord &event){ // Logs the event, then applies it; returns the affected record index
+        lock_guard<mutex> lock(storeMutex);
+        event.sequence = ++lastSequence;
+        if (!log.append(event)){
+            return -1;
+        }
+        long long recordIndex = apply(event);
+
+        if (log.size() >= checkpointSize){
+            checkpointLocked();
+        }
+        return recordIndex;
+    }
+
+    // Logs a whole batch, syncs the log once, then applies it; recordIndexes lines up with events
+    bool commitBatch(vector<LogRecord> &events, vector<long long> &recordIndexes){
+        lock_guard<mutex> lock(storeMutex);
+        for (LogRecord &event : events){
+            event.sequence = ++lastSequence;
+            if (!log.append(event)){
+                return false;
+            }
+        }
+        if (!log.sync()){
+            return false;
+        }
+
+        recordIndexes.clear();
+        for (const LogRecord &event : events){
+            recordIndexes.push_back(apply(event));
+        }
+        if (log.size() >= checkpointSize){
+            checkpointLocked();
+        }
+        return true;
+    }
+
+    bool sync(){
+        lock_guard<mutex> lock(storeMutex);
+        return log.sync();
+    }
+
+    CustomerRecord customerAt(size_t index){ // Copy taken under the lock, safe while other threads append
+        lock_guard<mutex> lock(storeMutex);
+        return customers.at(index);
+    }
+
+    bool checkpoint(){ // Once the stores are on disk the log is no longer needed
+        lock_guard<mutex> lock(storeMutex);
+        return checkpointLocked();
+    }
+};
+
+enum BookingResult{ // Outcome of every BookingEngine operation
+    BookingOk,
+    InvalidCustomerName,
+    InvalidCustomerID,
+    DuplicateCustomerID,
+    InvalidContact,
+    InvalidEmail,
+    InvalidDateFormat,
+    DateNotAvailable,
+    InvalidSlot,
+    SlotTaken,
+    AlreadyBooked,
+    AlreadyWaitlisted,
+    NoBooking,
+    InvalidTable,
+    TableTooSmall,
+    Waitlisted,
+    InvalidMenuItem,
+    AlreadyPaid,
+    InvalidPaymentMethod,
+    InvalidCardNumber,
+    InvalidTransactionID,
+    StorageError
+};
+
+const char *describeResult(BookingResult result){ // Console wording for each result
+    switch (result){
+    case BookingOk: return "Success.";
+    case InvalidCustomerName: return "Invalid name. It should only contain letters and spaces.";
+    case InvalidCustomerID: return "Customer ID must be 1 to 31 characters long.";
+    case DuplicateCustomerID: return "Customer ID already exists. Please enter a unique ID.";
+    case InvalidContact: return "Invalid contact number. Please try again.";
+    case InvalidEmail: return "Invalid email. Please try again.";
+    case InvalidDateFormat: return "Invalid date format or the date is in the past. Please follow the format (YYYY-MM-DD).";
+    case DateNotAvailable: return "The entered date is not available for reservation. Try another date.";
+    case InvalidSlot: return "Invalid slot number.";
+    case SlotTaken: return "Slot already reserved.";
+    case AlreadyBooked: return "You already have a reservation. Change or cancel it instead.";
+    case AlreadyWaitlisted: return "You are already on the waitlist.";
+    case NoBooking: return "There is no reservation to pay for. Make a reservation first.";
+    case TableTooSmall: return "That table cannot seat your party. Try another table.";
+    case Waitlisted: return "The slot is full. You are on the waitlist and will get a table if one frees up.";
+    case InvalidTable: return "Invalid table number. Try again.";
+    case InvalidMenuItem: return "Invalid Menu ID. Try again.";
+    case AlreadyPaid: return "Payment is already completed.";
+    case InvalidPaymentMethod: return "Invalid payment method selected.";
+    case InvalidCardNumber: return "Invalid credit card number. Payment failed.";
+    case InvalidTransactionID: return "Invalid Transaction ID. Payment failed.";
+    case StorageError: return "Error: Unable to open file for writing.";
+    }
+    return "Unknown error.";
+}
+
+// Console screens. While a Terminal is installed, everything sent to cout is composed into one frame and
+// written with a single call when the program next reads input, so endl no longer costs a write per line.
+// Screens are cleared with ANSI sequences and keys are read in-process: system("cls") and system("pause")
+// started a shell each, and Linux has no cls at all.
+class Terminal{
+private:
+    class FrameBuffer : public streambuf{ // cout's buffer while installed
+    private:
+        static const size_t largestFrame = 1 << 16; // Written early past this, e.g. output looping with no input
+
+        Terminal &terminal;
+
+    public:
+        string frame;
+
+        explicit FrameBuffer(Terminal &terminal) : terminal(terminal) {}
+
+    protected:
+        int overflow(int c) override{
+            if (c != EOF){
+                frame += static_cast<char>(c);
+            }
+            if (frame.size() > largestFrame){
+                terminal.present();
+            }
+            return c;
+        }
+
+        streamsize xsputn(const char *text, streamsize count) override{
+            frame.append(text, static_cast<size_t>(count));
+            if (frame.size() > largestFrame){
+                terminal.present();
+            }
+            return count;
+        }
+
+        int sync() override { return 0; } // endl ends a line, not a frame
+    };
+
+    class KeyboardBuffer : public streambuf{ // cin's buffer while installed: the frame is shown before any read
+    private:
+        Terminal &terminal;
+        streambuf *source;
+        char current = 0; // One-character get area, so unget still works
+
+    public:
+        KeyboardBuffer(Terminal &terminal, streambuf *source) : terminal(terminal), source(source) {}
+
+    protected:
+        int underflow() override{
+            terminal.present();
+            int c = source->sbumpc();
+            if (c == EOF){
+                return EOF;
+            }
+            current = traits_type::to_char_type(c);
+            setg(&current, &current, &current + 1);
+            return c;
+        }
+    };
+
+    static Terminal *active; // The installed terminal, if any
+
+    FrameBuffer frameBuffer;
+    KeyboardBuffer keyboardBuffer;
+    streambuf *savedOutput;
+    streambuf *savedInput;
+    int outputFile;
+    bool useEscapes; // Output is a terminal: clear with escape sequences, wait for keys
+    long long frames = 0;
+    long long writes = 0;
+
+    bool writeAll(const char *data, size_t size){
+        while (size > 0){
+#ifdef _WIN32
+            int written = _write(outputFile, data, static_cast<unsigned int>(min<size_t>(size, 1 << 30)));
+#else
+            ssize_t written = write(outputFile, data, size);
+#endif
+            if (written < 0 && errno == EINTR){
+                continue;
+            }
+            if (written <= 0){
+                return false;
+            }
+            writes++;
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+public:
+    static bool isTerminal(int file){
+#ifdef _WIN32
+        return _isatty(file) != 0;
+#else
+        return isatty(file) != 0;
+#endif
+    }
+
+    // Takes over cout and cin until destroyed. outputFile is where frames go, normally 1 (stdout).
+    Terminal(int outputFile, bool useEscapes)
+        : frameBuffer(*this), keyboardBuffer(*this, cin.rdbuf()), savedOutput(cout.rdbuf()), savedInput(cin.rdbuf()), outputFile(outputFile), useEscapes(useEscapes){
+        cout.flush();
+#ifdef _WIN32
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (useEscapes && GetConsoleMode(console, &mode)){ // Windows 10 consoles understand ANSI once asked to
+            SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
+#endif
+        cout.rdbuf(&frameBuffer);
+        cin.rdbuf(&keyboardBuffer);
+        active = this;
+    }
+
+    Terminal(const Terminal &) = delete;
+    Terminal &operator=(const Terminal &) = delete;
+
+    ~Terminal(){
+        present();
+        cout.rdbuf(savedOutput);
+        cin.rdbuf(savedInput);
+        if (active == this){
+            active = nullptr;
+        }
+    }
+
+    static Terminal *current() { return active; }
+
+    void present(){ // Writes the frame composed so far
+        if (frameBuffer.frame.empty()){
+            return;
+        }
+        writeAll(frameBuffer.frame.data(), frameBuffer.frame.size());
+        frameBuffer.frame.clear();
+        frames++;
+    }
+
+    void clear(){ // Starts a new screen; anything not shown yet would be wiped at once, so it is dropped
+        if (useEscapes){
+            frameBuffer.frame.assign("\x1b[H\x1b[2J\x1b[3J"); // Home, clear screen, clear scrollback
+        }
+    }
+
+    void waitForKey(){ // One key press, not echoed
+        if (!useEscapes || !isTerminal(0)){ // Nobody to press a key: scripted input is left for the prompts
+            present();
+            return;
+        }
+        cout << "Press any key to continue . . . ";
+        present();
+#ifdef _WIN32
+        _getch();
+#else
+        termios saved, raw;
+        bool isRaw = tcgetattr(STDIN_FILENO, &saved) == 0;
+        if (isRaw){
+            raw = saved;
+            raw.c_lflag &= ~(ICANON | ECHO);
+            raw.c_cc[VMIN] = 1;
+            raw.c_cc[VTIME] = 0;
+            tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        }
+        char key;
+        while (read(STDIN_FILENO, &key, 1) < 0 && errno == EINTR){
+        }
+        if (isRaw){
+            tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+        }
+#endif
+        cout << "\n";
+    }
+
+    long long frameCount() const { return frames; }
+    long long writeCount() const { return writes; }
+};
+
+Terminal *Terminal::active = nullptr;
+
+inline void clearScreen(){ // system("cls") without the shell
+    if (Terminal::current()){
+        Terminal::current()->clear();
+    }
+}
+
+inline void waitForKey(){ // system("pause") without the shell
+    if (Terminal::current()){
+        Terminal::current()->waitForKey();
+    }
+}
+
+class BaseReservation{
+public:
+    virtual void displayCustomerDetails() const = 0; // Pure virtual function for polymorphism
+    virtual void inputCustomerDetails() = 0;         // Pure virtual function for polymorphism
+    virtual ~BaseReservation() {}
+};
+
+class Reservation : public BaseReservation{ // Inherit from BaseReservation
+private:
+    SlotCalendar bookings; // Key: Day number, Value: one bit per (slot, table), 1=reserved
+
+public:
+    static const int totalSlots = 5; // Number of slots per day (10 AM to 8 PM at 2-hour intervals)
+    static const int tableBits = 12; // Bits per slot in the day word, so up to 12 tables
+    static const unsigned int tableBitsMask = (1u << tableBits) - 1;
+
+    Reservation() {}
+
+    static unsigned int takenTables(unsigned long long dayWord, int slot){ // Table bits (bit t-1 = table t) taken in a slot
+        return static_cast<unsigned int>(dayWord >> (slot * tableBits)) & tableBitsMask;
+    }
+
+    static unsigned long long everySlot(unsigned int tables){ // The same table bits repeated for all slots
+        unsigned long long word = 0;
+        for (int slot = 0; slot < totalSlots; slot++){
+            word |= static_cast<unsigned long long>(tables & tableBitsMask) << (slot * tableBits);
+        }
+        return word;
+    }
+
+    bool checkIfValidDate(const string &date){
+        return isValidDate(date); // Shares the hand-written date validator
+    }
+
+    unsigned long long getSlots(const string &date) const{ // Day word for a valid date; nothing is inserted
+        return bookings.getDay(dateToDayNumber(date));
+    }
+
+    unsigned long long getSlots(int dayNumber) const{
+        return bookings.getDay(dayNumber);
+    }
+
+    template <class SkipSpan, class Visit>
+    void scanSlots(int fromDay, int numDays, SkipSpan skipSpan, Visit visit) const{ // Day words of a range, see SlotCalendar::scanDays
+        bookings.scanDays(fromDay, numDays, skipSpan, visit);
+    }
+
+    // First (date, slot) with a free table among tables (bit t-1 = table t); foundSlot is 0-based
+    bool findFirstFreeSlot(const string &fromDate, int numDays, unsigned int tables, string &foundDate, int &foundSlot) const{
+        int foundDay, foundBit;
+        if (!bookings.findFirstFree(dateToDayNumber(fromDate), numDays, everySlot(tables), foundDay, foundBit)){
+            return false;
+        }
+        foundDate = dayNumberToDate(foundDay);
+        foundSlot = foundBit / tableBits;
+        return true;
+    }
+
+    static unsigned int tableRun(int table, int tableCount){ // Bits for tableCount adjacent tables from table on; 0 if out of range
+        if (table < 1 || tableCount < 1 || table + tableCount - 1 > tableBits){
+            return 0;
+        }
+        return ((1u << tableCount) - 1) << (table - 1);
+    }
+
+    // Tables a booking holds: a booking saved before tables were tracked (table -1) holds the whole slot,
+    // so restoring and releasing it both go through here
+    static unsigned int heldTables(int table, int tableCount){
+        return table < 1 ? tableBitsMask : tableRun(table, tableCount);
+    }
+
+    void restoreSlot(int dayNumber, int slot, int table, int tableCount){ // Re-marks a saved booking without any output
+        if (slot < 0 || slot >= totalSlots){
+            return;
+        }
+        bookings.reserveBits(dayNumber, static_cast<unsigned long long>(heldTables(table, tableCount)) << (slot * tableBits));
+    }
+
+    // slot is 0-based, table 1-based; all tableCount tables are taken together or not at all
+    BookingResult reserveSlot(const string &date, int slot, int table, int tableCount = 1){
+        if (!isValidDate(date)){ // validation for date
+            return InvalidDateFormat;
+        }
+
+        if (slot < 0 || slot >= totalSlots){ // validation for time slot
+            return InvalidSlot;
+        }
+
+        unsigned long long tables = tableRun(table, tableCount);
+        if (!tables){
+            return InvalidTable;
+        }
+
+        if (!bookings.reserveBits(dateToDayNumber(date), tables << (slot * tableBits))){ // Mark tables as reserved
+            return SlotTaken;
+        }
+        return BookingOk;
+    }
+
+    void releaseSlot(const string &date, int slot, int table, int tableCount = 1){ // Mirrors restoreSlot for table -1
+        unsigned long long tables = heldTables(table, tableCount);
+        if (isValidDate(date) && slot >= 0 && slot < totalSlots && tables){
+            bookings.releaseBits(dateToDayNumber(date), tables << (slot * tableBits));
+        }
+    }
+
+    // Any set of tables (bit t-1 = table t) in a 0-based slot; a move takes and frees what its two runs do not share
+    bool reserveTables(int dayNumber, int slot, unsigned int tables){
+        return bookings.reserveBits(dayNumber, static_cast<unsigned long long>(tables & tableBitsMask) << (slot * tableBits));
+    }
+
+    void releaseTables(int dayNumber, int slot, unsigned int tables){
+        bookings.releaseBits(dayNumber, static_cast<unsigned long long>(tables & tableBitsMask) << (slot * tableBits));
+    }
+
+    void inputCustomerDetails() override {}         // No input for Reservation, hence not needed here
+    void displayCustomerDetails() const override {} // No details to display for Reservation
+};
+
+string jsonEscape(const string &text){
+    string escaped;
+    escaped.reserve(text.size());
+    for (char c : text){
+        if (c == '"' || c == '\\'){
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20){
+            escaped += ' ';
+        } else{
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+bool jsonField(const string &body, const string &key, string &value){ // Flat objects only: "key": "text" or "key": 123
+    string quotedKey = "\"" + key + "\"";
+    size_t pos = body.find(quotedKey);
+    if (pos == string::npos){
+        return false;
+    }
+    pos = body.find(':', pos + quotedKey.size());
+    if (pos == string::npos){
+        return false;
+    }
+    pos = body.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == string::npos){
+        return false;
+    }
+
+    value.clear();
+    if (body[pos] == '"'){
+        for (size_t i = pos + 1; i < body.size(); i++){
+            if (body[i] == '\\' && i + 1 < body.size()){
+                value += body[++i];
+            } else if (body[i] == '"'){
+                return true;
+            } else{
+                value += body[i];
+            }
+        }
+        return false;
+    }
+
+    size_t end = body.find_first_of(",} \t\r\n", pos);
+    value = body.substr(pos, end == string::npos ? string::npos : end - pos);
+    return !value.empty();
+}
+
+int jsonInt(const string &body, const string &key, int fallback){
+    string value;
+    if (!jsonField(body, key, value)){
+        return fallback;
+    }
+    char *end;
+    long number = strtol(value.c_str(), &end, 10);
+    return *end == '\0' ? static_cast<int>(number) : fallback;
+}
+
+bool parseCentavos(const string &text, long long &centavos){ // "150", "99.5" or "1,250.75" -> centavos, no floating point
+    centavos = 0;
+    int decimals = -1;
+    bool hasDigit = false;
+    for (char c : text){
+        if (isDigitChar(c) && decimals < 2){
+            centavos = centavos * 10 + (c - '0');
+            hasDigit = true;
+            if (decimals >= 0){
+                decimals++;
+            }
+        } else if (c == '.' && decimals < 0){
+            decimals = 0;
+        } else if (c != ',' && c != ' ' && c != '\r'){
+            return false;
+        }
+        if (centavos > 100000000000LL){
+            return false;
+        }
+    }
+    for (int i = max(decimals, 0); i < 2; i++){
+        centavos *= 10;
+    }
+    return hasDigit;
+}
+
+string formatPesos(long long centavos){ // 123456 -> "1234.56"
+    string sign = centavos < 0 ? "-" : "";
+    centavos = centavos < 0 ? -centavos : centavos;
+    string fraction = to_string(centavos % 100);
+    return sign + to_string(centavos / 100) + "." + (fraction.length() < 2 ? "0" : "") + fraction;
+}
+
+class MenuCatalog{ // Every menu item, loaded once from menu.txt into parallel arrays grouped by category
+private:
+    static const int maxMenuID = 9999;
+
+    vector<int> itemIDs; // Row-aligned item columns, rows of one category are contiguous
+    vector<string> itemNames;
+    vector<long long> itemPrices; // Centavos
+    vector<int> itemCategories;             // Category handle per row
+    vector<int> rowByID;                    // Menu ID -> row, -1 if no such item
+    vector<string> categoryNames;           // Category handle -> name, in file order
+    vector<pair<int, int>> categoryRows;    // Category handle -> [first row, end row)
+    unordered_map<string, int> categoryIDs; // Category name -> handle
+    unsigned int contentVersion = 0;        // FNV-1a over every row; --bench-menu prints it to say which menu was timed
+
+    static void writeDefaultMenu(const string &fileName){ // The house menu, for a fresh install
+        ofstream outFile(fileName);
+        outFile << "# CATEGORY|ID|Name|Price\n"
+                << "PAMAWING-GUTOM|0|Calamares|150\n" << "PAMAWING-GUTOM|1|Chicharon Bulaklak|150\n"
+                << "PAMAWING-GUTOM|2|Dynamite|100\n" << "PAMAWING-GUTOM|3|Lumpiang Shanghai|180\n"
+                << "PAMAWING-GUTOM|4|Lumpiang Sariwa|180\n"
+                << "PANGUNAHING PAGKAIN|5|Adobo|450\n" << "PANGUNAHING PAGKAIN|6|Sinigang|450\n"
+                << "PANGUNAHING PAGKAIN|7|Dinuguan|400\n" << "PANGUNAHING PAGKAIN|8|Kare Kare|500\n"
+                << "PANGUNAHING PAGKAIN|9|Pinakbet|400\n"
+                << "PANGHIMAGAS|10|Sorbetes|100\n" << "PANGHIMAGAS|11|Halo Halo|150\n"
+                << "PANGHIMAGAS|12|Leche Flan|150\n" << "PANGHIMAGAS|13|Buko Pandan|100\n"
+                << "PANGHIMAGAS|14|Mais Con Yelo|100\n"
+                << "PANULAK|15|Sago't Gulaman|100\n" << "PANULAK|16|Mango Shake|120\n"
+                << "PANULAK|17|Buko Juice|80\n" << "PANULAK|18|Calamansi Juice|80\n"
+                << "PANULAK|19|Pineapple Juice|80\n";
+    }
+
+    int internCategory(const string &name){
+        auto found = categoryIDs.find(name);
+        if (found != categoryIDs.end()){
+            return found->second;
+        }
+        categoryNames.push_back(name);
+        return categoryIDs[name] = static_cast<int>(categoryNames.size()) - 1;
+    }
+
+    void load(const string &fileName){ // Lines of CATEGORY|ID|Name|Price; bad lines and repeated IDs are skipped
+        ifstream inFile(fileName);
+        if (!inFile.is_open()){
+            writeDefaultMenu(fileName);
+            inFile.open(fileName);
+        }
+
+        struct Row{
+            int category, id;
+            string name;
+            long long price;
+        };
+        vector<Row> rows;
+        string line;
+        while (getline(inFile, line)){
+            size_t first = line.find('|'), second = line.find('|', first + 1), third = line.find('|', second + 1);
+            if (line.empty() || line[0] == '#' || third == string::npos){
+                continue;
+            }
+            string idText = line.substr(first + 1, second - first - 1);
+            char *idEnd = nullptr;
+            long parsedID = strtol(idText.c_str(), &idEnd, 10);
+            long long price;
+            if (idText.empty() || !isdigit(static_cast<unsigned char>(idText[0])) || *idEnd != '\0' || parsedID > maxMenuID ||
+                !parseCentavos(line.substr(third + 1), price)){
+                continue; // Digits only: "abc" or "7x" would otherwise load as dish 0 or 7
+            }
+            int id = static_cast<int>(parsedID);
+            if (static_cast<int>(rowByID.size()) <= id){
+                rowByID.resize(id + 1, -1);
+            }
+            if (rowByID[id] != -1){
+                continue;
+            }
+            rowByID[id] = 0; // Claimed; the real row is set below
+            rows.push_back(Row{internCategory(line.substr(0, first)), id, line.substr(second + 1, third - second - 1), price});
+        }
+
+        stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b){ return a.category < b.category; });
+        categoryRows.assign(categoryNames.size(), make_pair(0, 0));
+        for (size_t row = 0; row < rows.size(); row++){
+            if (row == 0 || rows[row].category != rows[row - 1].category){
+                categoryRows[rows[row].category].first = static_cast<int>(row);
+            }
+            categoryRows[rows[row].category].second = static_cast<int>(row) + 1;
+            rowByID[rows[row].id] = static_cast<int>(row);
+            itemIDs.push_back(rows[row].id);
+            itemNames.push_back(rows[row].name);
+            itemPrices.push_back(rows[row].price);
+            itemCategories.push_back(rows[row].category);
+        }
+
+        unsigned int hash = 2166136261u;
+        auto mix = [&](const string &text){
+            for (char c : text){
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            hash = (hash ^ '|') * 16777619u;
+        };
+        for (const Row &row : rows){
+            mix(categoryNames[row.category]);
+            mix(to_string(row.id));
+            mix(row.name);
+            mix(to_string(row.price));
+        }
+        contentVersion = hash;
+    }
+
+    MenuCatalog(){
+        load("menu.txt");
+    }
+
+public:
+    MenuCatalog(const MenuCatalog &) = delete;
+    MenuCatalog &operator=(const MenuCatalog &) = delete;
+
+    static const MenuCatalog &instance(){ // Loaded on first use; safe from any thread
+        static const MenuCatalog catalog;
+        return catalog;
+    }
+
+    unsigned int version() const { return contentVersion; }
+    int categoryCount() const { return static_cast<int>(categoryNames.size()); }
+    const string &categoryName(int category) const { return categoryNames[category]; }
+    pair<int, int> rowsOf(int category) const { return categoryRows[category]; }
+
+    int categoryHandle(const string &name) const{ // -1 if the catalog has no such category
+        auto found = categoryIDs.find(name);
+        return found == categoryIDs.end() ? -1 : found->second;
+    }
+
+    int rowOf(int menuID) const{ // -1 if no such item
+        return menuID >= 0 && menuID < static_cast<int>(rowByID.size()) ? rowByID[menuID] : -1;
+    }
+
+    bool contains(int menuID) const { return rowOf(menuID) >= 0; }
+    int itemCount() const { return static_cast<int>(itemIDs.size()); }
+
+    int idAt(int row) const { return itemIDs[row]; }
+    const string &nameAt(int row) const { return itemNames[row]; }
+    long long priceAt(int row) const { return itemPrices[row]; } // Centavos
+    int categoryAt(int row) const { return itemCategories[row]; }
+
+    string nameOf(int menuID) const{ // Item name, or "Item N" for an ID no longer on the menu
+        int row = rowOf(menuID);
+        return row >= 0 ? itemNames[row] : "Item " + to_string(menuID);
+    }
+};
+
+class Menu : public BaseReservation{ // Inherit from BaseReservation; a view of one category of the catalog
+protected:
+    int category; // Catalog handle, -1 for an empty menu
+
+    struct RenderedTables{ // Every category's table, formatted once
+        vector<string> tables; // Category handle -> table
+        string fullMenu;       // Every table, each followed by a blank line
+    };
+
+    static const RenderedTables &renderedTables(){ // Built on first use; the catalog is loaded once and never changes after
+        static const RenderedTables rendered = [](){
+            const MenuCatalog &catalog = MenuCatalog::instance();
+            RenderedTables built;
+            built.tables.assign(catalog.categoryCount(), string());
+            for (int handle = 0; handle < catalog.categoryCount(); handle++){
+                ostringstream table;
+                formatTable(table, handle);
+                built.tables[handle] = table.str();
+                built.fullMenu += built.tables[handle] + "\n";
+            }
+            return built;
+        }();
+        return rendered;
+    }
+
+public:
+    Menu() : category(-1) {}
+
+    explicit Menu(int category) : category(category) {}
+
+    Menu(const string &category) : category(MenuCatalog::instance().categoryHandle(category)) {}
+
+    bool hasItem(int menuID) const{
+        int row = MenuCatalog::instance().rowOf(menuID);
+        pair<int, int> rows = category < 0 ? make_pair(0, 0) : MenuCatalog::instance().rowsOf(category);
+        return row >= rows.first && row < rows.second;
+    }
+
+    static void formatTable(ostream &out, int category){ // One category's table; screens show the cached copy
+        const MenuCatalog &catalog = MenuCatalog::instance();
+        const string &name = catalog.categoryName(category);
+        int padding = max(0, (43 - static_cast<int>(name.length())) / 2);
+        out << string(padding, ' ') << name << "\n";
+        out << string(43, '-') << "\n";
+        out << setw(10) << left << "ID"
+            << setw(25) << left << "Name"
+            << setw(10) << left << "Price" << "\n";
+        out << string(43, '-') << "\n";
+
+        pair<int, int> rows = catalog.rowsOf(category);
+        for (int row = rows.first; row < rows.second; row++){
+            out << setw(10) << left << catalog.idAt(row)
+                << setw(25) << left << catalog.nameAt(row)
+                << setw(10) << left << formatPesos(catalog.priceAt(row)) << "\n";
+        }
+        out << string(43, '-') << "\n";
+    }
+
+    static const string &fullMenu() { return renderedTables().fullMenu; } // Every category, as displayFullMenu shows it
+
+    void displayMenu() const{
+        if (category < 0){
+            return;
+        }
+        cout << renderedTables().tables[category];
+    }
+    void inputCustomerDetails() override {}         // No input for Menu, hence not needed here
+    void displayCustomerDetails() const override {} // No details to display for Menu
+};
+
+class Customer : public BaseReservation{ // Inherit from BaseReservation; fields are stored inline, so copies never allocate
+private:
+    CustomerRecord fields;     // The layout customers.dat uses, NUL-terminated
+    unsigned char tooLong = 0; // TooLong bits of the fields whose input did not fit
+
+    static ShardedIDSet customerIDs;
+
+public:
+    enum TooLong { NameTooLong = 1, ContactTooLong = 2, EmailTooLong = 4, IDTooLong = 8 };
+
+    Customer() : fields() {}
+
+    Customer(const string &name, const string &contact, const string &email, const string &id){
+        copyField(fields.customerName, name);
+        copyField(fields.contactNumber, contact);
+        copyField(fields.customerEmail, email);
+        copyField(fields.customerID, id);
+        tooLong = (name.length() >= sizeof(fields.customerName) ? NameTooLong : 0) |
+                  (contact.length() >= sizeof(fields.contactNumber) ? ContactTooLong : 0) |
+                  (email.length() >= sizeof(fields.customerEmail) ? EmailTooLong : 0) |
+                  (id.length() >= sizeof(fields.customerID) ? IDTooLong : 0);
+    }
+
+    string getCustomerName() const { return fieldToString(fields.customerName); }
+    string getCustomerID() const { return fieldToString(fields.customerID); }
+    string getContactNumber() const { return fieldToString(fields.contactNumber); }
+    string getCustomerEmail() const { return fieldToString(fields.customerEmail); }
+
+    bool isTooLong(TooLong field) const { return (tooLong & field) != 0; } // Truncated; registration rejects it
+
+    void inputCustomerDetails() override {
+        string customerName, customerID, contactNumber, customerEmail;
+        cin.ignore();
+        bool isCustomerNameValid = false;
+
+        do {
+            clearScreen();
+            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
+            cout << "Enter your name: ";
+            getline(cin, customerName);
+
+            if (customerName.length() >= sizeof(fields.customerName)) {
+                cout << "Name must be at most " << sizeof(fields.customerName) - 1 << " characters long." << endl;
+                waitForKey();
+            } else if (isValidCustomerName(customerName)) {
+                isCustomerNameValid = true;
+            } else {
+                cout << "Invalid name. It should only contain letters and spaces." << endl;
+                waitForKey();
+            }
+        } while (!isCustomerNameValid);
+
+        bool isCustomerIDValid = false;
+        do {
+            clearScreen();
+            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
+            cout << "Name: " << customerName << endl << endl;
+            cout << "Enter your ID: ";
+            getline(cin, customerID);
+
+            if (customerID.empty() || customerID.length() >= sizeof(CustomerRecord::customerID)) {
+                cout << "Customer ID must be 1 to " << sizeof(CustomerRecord::customerID) - 1 << " characters long." << endl;
+                waitForKey();
+            } else if (customerIDs.contains(customerID)) { // BookingEngine::registerCustomer claims it
+                cout << "Customer ID already exists. Please enter a unique ID." << endl;
+                waitForKey();
+            } else {
+                isCustomerIDValid = true;
+            }
+        } while (!isCustomerIDValid);
+
+            bool isContactNumberValid = false;
+            do {
+                clearScreen();
+                cout << "INPUT CUSTOMER DETAILS" << endl << endl;
+                cout << "Name: " << customerName << endl;
+                cout << "ID: " << customerID << endl << endl;
+                cout << "Enter your contact number: ";
+                getline(cin, contactNumber);
+
+                if (isValidContactInput(contactNumber)) {
+                    isContactNumberValid = true;
+                } else {
+                    cout << "Invalid contact number. Please try again." << endl;
+                    waitForKey();
+                }
+            } while (!isContactNumberValid);
+
+            bool isCustomerEmailValid = false;
+            do {
+                clearScreen();
+                cout << "INPUT CUSTOMER DETAILS" << endl << endl;
+                cout << "Name: " << customerName << endl;
+                cout << "ID: " << customerID << endl;
+                cout << "Contact Number: " << contactNumber << endl << endl;
+                cout << "Enter your email: ";
+                getline(cin, customerEmail);
+
+                if (customerEmail.length() >= sizeof(fields.customerEmail)) {
+                    cout << "Email must be at most " << sizeof(fields.customerEmail) - 1 << " characters long." << endl;
+                    waitForKey();
+                } else if (isValidEmail(customerEmail)) {
+                    isCustomerEmailValid = true;
+                } else {
+                    cout << "Invalid email. Please try again." << endl;
+                    waitForKey();
+                }
+            } while (!isCustomerEmailValid);
+
+            clearScreen();
+            cout << "INPUT CUSTOMER DETAILS" << endl << endl;
+            cout << "Name: " << customerName << endl;
+            cout << "ID: " << customerID << endl;
+            cout << "Contact Number: " << contactNumber << endl;
+            cout << "Email: " << customerEmail << endl << endl;
+            waitForKey();
+
+            *this = Customer(customerName, contactNumber, customerEmail, customerID);
+    }
+
+    void displayCustomerDetails() const override{ // Display customer details
+        clearScreen();
+        cout << "Customer Details:" << endl;
+        cout << "Name: " << getCustomerName() << endl;
+        cout << "Contact Number: " << getContactNumber() << endl;
+        cout << "Email: " << getCustomerEmail() << endl;
+        cout << "Customer ID: " << getCustomerID() << endl;
+    }
+
+    const CustomerRecord &toRecord() const { return fields; }
+
+    static Customer fromRecord(const CustomerRecord &record){
+        Customer customer;
+        customer.fields = record;
+        return customer;
+    }
+
+    static bool registerID(const string &id){ return customerIDs.insert(id); } // False if the ID was already taken
+    static void releaseID(const string &id){ customerIDs.erase(id); }          // Gives back an ID whose record was never stored
+
+    long long saveToFile(ReservationStore &store) const{ // Save customer details, returns the record index (-1 on failure)
+        LogRecord event = {};
+        event.type = LogCustomer;
+        event.customer = toRecord();
+        return store.commit(event);
+    }
+};
+
+ShardedIDSet Customer::customerIDs;
+
+class TableArea : public BaseReservation{ // Inherit from BaseReservation
+private:
+    int tableId, numberOfSeats;
+    bool isAvailable;
+
+public:
+    TableArea(int tableId, int numberOfSeats, bool isAvailable) : tableId(tableId), numberOfSeats(numberOfSeats), isAvailable(isAvailable) {}
+
+    int getTableId() const { return tableId; }
+    int getNumberOfSeats() const { return numberOfSeats; }
+
+    static const vector<TableArea> &restaurantTables(){ // The dining room, in table number order
+        static const vector<TableArea> tables = {
+            TableArea(1, 2, true), TableArea(2, 2, true), TableArea(3, 4, true), TableArea(4, 4, true), TableArea(5, 6, true),
+            TableArea(6, 6, true), TableArea(7, 8, true), TableArea(8, 8, true), TableArea(9, 10, true), TableArea(10, 10, true)};
+        return tables;
+    }
+
+    void viewAvailableAreas(){
+        cout << "Available Tables:" << endl;
+        for (const TableArea &table : restaurantTables()){
+            cout << "Table " << table.tableId << ": Good for " << table.numberOfSeats << " people" << endl;
+        }
+        cout << endl;
+    }
+
+    static bool isValidTable(int table){
+        return table >= 1 && table <= static_cast<int>(restaurantTables().size());
+    }
+
+    static const int maxJoinedTables = 3; // Most adjacent tables pushed together for one party
+
+    static int seatsAt(int table, int tableCount = 1){ // Seats at tableCount adjacent tables pushed together
+        int seats = 0;
+        for (int t = table; t < table + tableCount; t++){
+            if (!isValidTable(t)){
+                return 0;
+            }
+            seats += restaurantTables()[t - 1].numberOfSeats;
+        }
+        return seats;
+    }
+
+    static int largestParty(){ // Most guests any table or joined tables can seat
+        int seats = 0;
+        for (const TableArea &table : restaurantTables()){
+            for (int count = 1; count <= maxJoinedTables; count++){
+                seats = max(seats, seatsAt(table.tableId, count));
+            }
+        }
+        return seats;
+    }
+
+    int reserveTable(int &partySize){ // Returns the chosen table number, or 0 for best fit; partySize is asked first
+        cout << "RESERVE TABLE AREA" << endl;
+
+        partySize = 0;
+        while (partySize < 1){
+            cout << "Enter number of guests: ";
+            cin >> partySize;
+
+            if (cin.fail() || partySize < 1 || partySize > largestParty()){
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << "Invalid number of guests. Try again." << endl;
+                partySize = 0;
+            }
+        }
+
+        if (partySize > restaurantTables().back().numberOfSeats){
+            cout << "Your party needs joined tables. We will seat you at the best tables for your chosen time." << endl;
+            return 0;
+        }
+
+        bool isReserved = false;
+        int reservedTable = -1;
+        while (!isReserved){
+            clearScreen();
+            viewAvailableAreas(); // display tables
+
+            cout << "Enter table number (1-" << restaurantTables().size() << ", 0 to let us choose): ";
+            cin >> reservedTable;
+
+            if (reservedTable == 0){
+                cout << "We will seat you at the best table for your chosen time." << endl;
+                return 0;
+            } else if (!isValidTable(reservedTable)){ // validation for table
+                cout << "Invalid table number. Try again." << endl;
+                reservedTable = -1;
+                waitForKey();
+            } else if (seatsAt(reservedTable) < partySize){
+                cout << "Table " << reservedTable << " is only good for " << seatsAt(reservedTable) << " people. Try again." << endl;
+                waitForKey();
+            } else{
+                isReserved = true;
+                cout << "You have selected Table " << reservedTable << endl;
+                return reservedTable;
+            }
+        }
+        return -1;
+    }
+    void inputCustomerDetails() override {}         // No input for TableArea, hence not needed here
+    void displayCustomerDetails() const override {} // No details to display for TableArea
+};
+
+struct TableGroup{ // One table, or adjacent tables pushed together
+    unsigned int tables = 0; // bit t-1 = table t
+    int firstTable = -1;
+    int tableCount = 0;
+    int seats = 0;
+};
+
+class TableInventory{ // Seat-capacity buckets and joinable table groups over the table bits of Reservation's day words
+private:
+    struct SeatBucket{
+        int seats;
+        unsigned int tables; // bit t-1 = table t
+    };
+
+    vector<SeatBucket> buckets; // Ascending by seats
+    vector<TableGroup> groups;  // Every single table and adjacent run, ascending by seats then table count
+    unsigned int allTables = 0;
+    unsigned char largestFree[1u << Reservation::tableBits]; // Taken table bits -> most seats of any free group
+
+    int freeNeighbours(const TableGroup &group, unsigned int takenTables) const{ // Free tables a group would cut off from joining
+        unsigned int neighbours = ((group.tables << 1) | (group.tables >> 1)) & allTables & ~group.tables;
+        int count = 0;
+        for (unsigned int freeTables = neighbours & ~takenTables; freeTables; freeTables &= freeTables - 1){
+            count++;
+        }
+        return count;
+    }
+
+public:
+    TableInventory(){
+        const vector<TableArea> &tables = TableArea::restaurantTables();
+        for (const TableArea &table : tables){
+            auto it = buckets.begin();
+            while (it != buckets.end() && it->seats < table.getNumberOfSeats()){
+                ++it;
+            }
+            if (it == buckets.end() || it->seats != table.getNumberOfSeats()){
+                it = buckets.insert(it, SeatBucket{table.getNumberOfSeats(), 0});
+            }
+            it->tables |= 1u << (table.getTableId() - 1);
+            allTables |= 1u << (table.getTableId() - 1);
+        }
+
+        for (const TableArea &table : tables){
+            for (int count = 1; count <= TableArea::maxJoinedTables && TableArea::isValidTable(table.getTableId() + count - 1); count++){
+                groups.push_back(TableGroup{Reservation::tableRun(table.getTableId(), count), table.getTableId(), count,
+                                            TableArea::seatsAt(table.getTableId(), count)});
+            }
+        }
+        stable_sort(groups.begin(), groups.end(), [](const TableGroup &a, const TableGroup &b){
+            return a.seats != b.seats ? a.seats < b.seats : a.tableCount < b.tableCount;
+        });
+
+        for (unsigned int taken = 0; taken <= Reservation::tableBitsMask; taken++){
+            int seats = 0;
+            for (const TableGroup &group : groups){
+                if (!(group.tables & taken)){
+                    seats = max(seats, group.seats);
+                }
+            }
+            largestFree[taken] = static_cast<unsigned char>(min(seats, 255));
+        }
+    }
+
+    unsigned int tableMask() const { return allTables; }
+
+    int largestFreeGroup(unsigned int takenTables) const{ // Most guests one free table or joined run can seat
+        return largestFree[takenTables & Reservation::tableBitsMask];
+    }
+
+    // Bit s set when slot s (0-based) of the day word can still seat the party; partySize 0 asks for any free table.
+    // Same answer as bestFit per slot, from a table lookup.
+    unsigned int openSlots(unsigned long long dayWord, int partySize) const{
+        int needed = max(partySize, 1);
+        unsigned int slots = 0;
+        for (int slot = 0; slot < Reservation::totalSlots; slot++){
+            if (largestFree[Reservation::takenTables(dayWord, slot)] >= needed){
+                slots |= 1u << slot;
+            }
+        }
+        return slots;
+    }
+
+    // freeSlots[i] = slots of day fromDay + i that can seat the party, for numDays days. Reads the calendar
+    // only; spans the week summary shows as full for this party are filled with 0 without reading their days.
+    void freeSlotsPerDay(const Reservation &reservation, int fromDay, int numDays, int partySize, unsigned char *freeSlots,
+                         bool useSummary = true) const{
+        fill(freeSlots, freeSlots + max(numDays, 0), 0);
+        reservation.scanSlots(fromDay, numDays,
+            [&](unsigned long long taken){ return useSummary && openSlots(taken, partySize) == 0; },
+            [&](int day, unsigned long long dayWord){
+                unsigned int slots = openSlots(dayWord, partySize);
+                int count = 0;
+                for (; slots; slots &= slots - 1){
+                    count++;
+                }
+                freeSlots[day - fromDay] = static_cast<unsigned char>(count);
+                return true;
+            });
+    }
+
+    // First maxDates days within numDays of fromDay where the party fits in some slot; slotMasks[i] has bit s
+    // set for each open 0-based slot. Returns how many were found.
+    int firstOpenDates(const Reservation &reservation, int fromDay, int numDays, int partySize, int maxDates, int *dayNumbers,
+                       unsigned int *slotMasks, bool useSummary = true) const{
+        int found = 0;
+        if (maxDates < 1){
+            return 0;
+        }
+        reservation.scanSlots(fromDay, numDays,
+            [&](unsigned long long taken){ return useSummary && openSlots(taken, partySize) == 0; },
+            [&](int day, unsigned long long dayWord){
+                unsigned int slots = openSlots(dayWord, partySize);
+                if (slots){
+                    dayNumbers[found] = day;
+                    slotMasks[found] = slots;
+                    found++;
+                }
+                return found < maxDates;
+            });
+        return found;
+    }
+
+    unsigned int tablesSeating(int partySize) const{ // Every table with at least partySize seats
+        unsigned int tables = 0;
+        for (const SeatBucket &bucket : buckets){
+            if (bucket.seats >= partySize){
+                tables |= bucket.tables;
+            }
+        }
+        return tables;
+    }
+
+    // Smallest free table seating partySize, given the taken table bits of one slot; -1 if none
+    int smallestFreeTable(unsigned int takenTables, int partySize) const{
+        for (const SeatBucket &bucket : buckets){
+            unsigned int freeTables = bucket.tables & ~takenTables;
+            if (bucket.seats >= partySize && freeTables){
+                return lowestSetBit(freeTables) + 1;
+            }
+        }
+        return -1;
+    }
+
+    // Best-fit seating for one arriving party: fewest empty seats, then fewest joined tables, then the
+    // group that leaves the fewest free neighbours stranded. Looks only at this slot's taken bits.
+    bool bestFit(unsigned int takenTables, int partySize, TableGroup &found) const{
+        auto first = lower_bound(groups.begin(), groups.end(), partySize, [](const TableGroup &group, int seats){
+            return group.seats < seats;
+        });
+        bool isFound = false;
+        int foundNeighbours = 0;
+        for (auto it = first; it != groups.end(); ++it){
+            if (isFound && (it->seats != found.seats || it->tableCount != found.tableCount)){
+                break; // Past the best seat count and table count
+            }
+            if (it->tables & takenTables){
+                continue;
+            }
+            int neighbours = freeNeighbours(*it, takenTables);
+            if (!isFound || neighbours < foundNeighbours){
+                found = *it;
+                foundNeighbours = neighbours;
+                isFound = true;
+            }
+        }
+        return isFound;
+    }
+};
+
+struct Waiter{
+    string customerID;
+    int partySize;
+    unsigned long long sequence; // Order of joining; the lowest eligible sequence is served first
+};
+
+class Waitlist{ // Parties waiting for a (day, slot), in one min-heap per party size
+private:
+    struct JoinedLater{
+        bool operator()(const Waiter &a, const Waiter &b) const { return a.sequence > b.sequence; }
+    };
+    typedef priority_queue<Waiter, vector<Waiter>, JoinedLater> WaiterQueue;
+
+    map<pair<int, int>, vector<WaiterQueue>> queues; // (day, 0-based slot) -> heaps indexed by party size
+    unordered_set<string> waitingIDs;                 // Customers in any line; each may hold one place at a time
+    unsigned long long nextSequence = 0;
+    size_t waiting = 0;
+
+public:
+    void add(int dayNumber, int slot, const string &customerID, int partySize){ // O(log n)
+        requeue(dayNumber, slot, Waiter{customerID, partySize, nextSequence++});
+    }
+
+    void requeue(int dayNumber, int slot, const Waiter &waiter){ // Puts a waiter back with their original place in line
+        vector<WaiterQueue> &bySize = queues[make_pair(dayNumber, slot)];
+        if (bySize.size() <= static_cast<size_t>(waiter.partySize)){
+            bySize.resize(waiter.partySize + 1);
+        }
+        bySize[waiter.partySize].push(waiter);
+        waitingIDs.insert(waiter.customerID);
+        waiting++;
+    }
+
+    // Takes the longest-waiting party of at most maxParty guests: one look at each size's head, then one pop
+    bool next(int dayNumber, int slot, int maxParty, Waiter &found){
+        auto it = queues.find(make_pair(dayNumber, slot));
+        if (it == queues.end()){
+            return false;
+        }
+        vector<WaiterQueue> &bySize = it->second;
+        int bestSize = -1;
+        for (int size = 1; size <= maxParty && size < static_cast<int>(bySize.size()); size++){
+            if (!bySize[size].empty() && (bestSize < 0 || bySize[size].top().sequence < bySize[bestSize].top().sequence)){
+                bestSize = size;
+            }
+        }
+        if (bestSize < 0){
+            return false;
+        }
+
+        found = bySize[bestSize].top();
+        bySize[bestSize].pop();
+        waitingIDs.erase(found.customerID);
+        waiting--;
+        if (all_of(bySize.begin(), bySize.end(), [](const WaiterQueue &queue){ return queue.empty(); })){
+            queues.erase(it);
+        }
+        return true;
+    }
+
+    size_t size() const { return waiting; }
+    bool contains(const string &customerID) const { return waitingIDs.count(customerID) > 0; }
+};
+
+struct Promotion{ // A booking made for a waiter after a cancellation, until their session picks it up
+    long long bookingIndex;
+    int dayNumber;
+    int slot; // 1-based
+    int table;
+    int tableCount;
+    int partySize;
+};
+
+struct BillingRules{ // Rates in basis points (1/100 of a percent), amounts in centavos
+    long long reservationFee = 50000;    // Per booking, not taxed
+    int serviceChargeBasisPoints = 1000; // 10% on food after discount
+    int taxBasisPoints = 1200;           // 12% VAT on food after discount plus service charge
+};
+
+struct BillLine{
+    int menuID;
+    int quantity;
+    long long unitPrice; // Centavos
+    long long amount;    // Centavos
+};
+
+struct Bill{ // Every amount in centavos; total = reservationFee + subtotal - discount + serviceCharge + tax
+    vector<BillLine> lines;
+    long long reservationFee = 0;
+    long long subtotal = 0;
+    long long discount = 0;
+    long long serviceCharge = 0;
+    long long tax = 0;
+    long long total = 0;
+};
+
+struct BillingTotals{ // Sum of many bills for an end-of-day run
+    long long bills = 0;
+    long long subtotal = 0;
+    long long discount = 0;
+    long long serviceCharge = 0;
+    long long tax = 0;
+    long long total = 0;
+};
+
+class BillingEngine{ // Prices orders from the menu catalog with integer centavo arithmetic only
+private:
+    BillingRules rules;
+
+    static long long applyRate(long long amount, int basisPoints){ // Rounded half up to the centavo
+        return (amount * basisPoints + 5000) / 10000;
+    }
+
+public:
+    BillingEngine() {}
+    explicit BillingEngine(const BillingRules &rules) : rules(rules) {}
+
+    // Lines are (menu ID, quantity); repeated IDs are merged, unknown IDs are left out of the bill
+    template <typename OrderLines> // Any container of (menu ID, quantity) pairs
+    Bill price(const OrderLines &orderLines, int bookingCount, int discountBasisPoints = 0) const{
+        const MenuCatalog &catalog = MenuCatalog::instance();
+        Bill bill;
+        for (const auto &orderLine : orderLines){
+            int row = catalog.rowOf(orderLine.first);
+            if (row < 0 || orderLine.second < 1){
+                continue;
+            }
+            auto existing = find_if(bill.lines.begin(), bill.lines.end(), [&](const BillLine &line){ return line.menuID == orderLine.first; });
+            if (existing == bill.lines.end()){
+                bill.lines.push_back(BillLine{orderLine.first, 0, catalog.priceAt(row), 0});
+                existing = bill.lines.end() - 1;
+            }
+            existing->quantity += orderLine.second;
+            existing->amount = existing->unitPrice * existing->quantity;
+        }
+
+        for (const BillLine &line : bill.lines){
+            bill.subtotal += line.amount;
+        }
+        bill.reservationFee = rules.reservationFee * bookingCount;
+        bill.discount = applyRate(bill.subtotal, max(0, min(discountBasisPoints, 10000)));
+        bill.serviceCharge = applyRate(bill.subtotal - bill.discount, rules.serviceChargeBasisPoints);
+        bill.tax = applyRate(bill.subtotal - bill.discount + bill.serviceCharge, rules.taxBasisPoints);
+        bill.total = bill.reservationFee + bill.subtotal - bill.discount + bill.serviceCharge + bill.tax;
+        return bill;
+    }
+
+    static void addTo(BillingTotals &totals, const Bill &bill){
+        totals.bills++;
+        totals.subtotal += bill.subtotal;
+        totals.discount += bill.discount;
+        totals.serviceCharge += bill.serviceCharge;
+        totals.tax += bill.tax;
+        totals.total += bill.total;
+    }
+};
+
+struct KitchenTicket{ // One order line for the kitchen; a negative quantity takes dishes back off the board
+    int dayNumber;
+    int slot; // 1-based
+    int menuID;
+    int quantity;
+};
+
+struct KitchenBatch{ // Every portion of one dish due for one slot
+    int dayNumber;
+    int slot;
+    int station; // Menu catalog category handle
+    int menuID;
+    int quantity;
+};
+
+class KitchenQueue{ // Sessions push tickets into a lock-free ring; the kitchen side folds them into per-slot dish batches
+private:
+    static const size_t ringSize = 4096;
+
+    MpscRing<KitchenTicket, ringSize> ring;
+    mutex consumerMutex; // Whoever holds it is the ring's single consumer
+    map<tuple<int, int, int, int>, int> pending; // (day, slot, station, menu ID) -> portions, so one slot's stations sit together
+
+    void drainLocked(){
+        const MenuCatalog &catalog = MenuCatalog::instance();
+        KitchenTicket ticket;
+        while (ring.tryPop(ticket)){
+            int row = catalog.rowOf(ticket.menuID);
+            auto key = make_tuple(ticket.dayNumber, ticket.slot, row >= 0 ? catalog.categoryAt(row) : -1, ticket.menuID);
+            if ((pending[key] += ticket.quantity) <= 0){
+                pending.erase(key);
+            }
+        }
+    }
+
+    vector<KitchenBatch> collect(int dayNumber, int slot, bool isFiring){
+        lock_guard<mutex> lock(consumerMutex);
+        drainLocked();
+
+        vector<KitchenBatch> batches;
+        auto first = pending.lower_bound(make_tuple(dayNumber, slot, numeric_limits<int>::min(), numeric_limits<int>::min()));
+        auto last = first;
+        for (; last != pending.end() && get<0>(last->first) == dayNumber && get<1>(last->first) == slot; ++last){
+            batches.push_back(KitchenBatch{dayNumber, slot, get<2>(last->first), get<3>(last->first), last->second});
+        }
+        if (isFiring){
+            pending.erase(first, last);
+        }
+        return batches;
+    }
+
+public:
+    void push(const KitchenTicket &ticket){ // Never drops: a producer that finds the ring full drains it itself
+        while (!ring.tryPush(ticket)){
+            lock_guard<mutex> lock(consumerMutex);
+            drainLocked();
+        }
+    }
+
+    vector<KitchenBatch> batches(int dayNumber, int slot){ // What is due for the slot, grouped by station then dish
+        return collect(dayNumber, slot, false);
+    }
+
+    vector<KitchenBatch> fire(int dayNumber, int slot){ // Same, and takes the batches off the board
+        return collect(dayNumber, slot, true);
+    }
+};
+
+class LineReader{ // Reads a text file in large chunks and hands out one line at a time
+private:
+    static const size_t chunkSize = 1 << 20;
+
+    FILE *file;
+    vector<char> chunk;
+    size_t chunkPos = 0, chunkLength = 0;
+
+public:
+    explicit LineReader(const string &fileName) : file(fopen(fileName.c_str(), "rb")), chunk(chunkSize) {}
+    LineReader(const LineReader &) = delete;
+    LineReader &operator=(const LineReader &) = delete;
+
+    ~LineReader(){
+        if (file){
+            fclose(file);
+        }
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    bool nextLine(string &line){ // Without the line ending; false at end of file
+        line.clear();
+        while (file){
+            if (chunkPos == chunkLength){
+                chunkLength = fread(chunk.data(), 1, chunk.size(), file);
+                chunkPos = 0;
+                if (chunkLength == 0){
+                    return !line.empty();
+                }
+            }
+
+            const char *start = chunk.data() + chunkPos;
+            const char *newline = static_cast<const char *>(memchr(start, '\n', chunkLength - chunkPos));
+            size_t length = newline ? static_cast<size_t>(newline - start) : chunkLength - chunkPos;
+            line.append(start, length);
+            chunkPos += length + (newline ? 1 : 0);
+            if (newline){
+                if (!line.empty() && line.back() == '\r'){
+                    line.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+bool splitCsvLine(const string &line, vector<string> &fields){ // RFC 4180 quoting on one line; false on an unclosed quote
+    size_t count = 0;
+    size_t pos = 0;
+    while (true){
+        if (fields.size() <= count){
+            fields.emplace_back();
+        }
+        string &field = fields[count++];
+        field.clear();
+
+        if (pos < line.size() && line[pos] == '"'){
+            for (pos++;; pos++){
+                if (pos >= line.size()){
+                    return false;
+                }
+                if (line[pos] == '"'){
+                    if (pos + 1 < line.size() && line[pos + 1] == '"'){
+                        field += '"';
+                        pos++;
+                    } else{
+                        pos++;
+                        break;
+                    }
+                } else{
+                    field += line[pos];
+                }
+            }
+        } else{
+            size_t end = line.find(',', pos);
+            field.assign(line, pos, end == string::npos ? string::npos : end - pos);
+            pos = end == string::npos ? line.size() : end;
+        }
+
+        if (pos >= line.size()){
+            fields.resize(count);
+            return true;
+        }
+        pos++; // Past the comma
+    }
+}
+
+string csvField(const string &text){ // Quotes the field only when it needs it
+    if (text.find_first_of(",\"\r\n") == string::npos){
+        return text;
+    }
+    string quoted = "\"";
+    for (char c : text){
+        quoted += c;
+        if (c == '"'){
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+struct ImportReport{
+    long long rows = 0;     // Data rows read, header excluded
+    long long imported = 0; // Bookings committed
+    long long newCustomers = 0;
+    long long rejected = 0; // Written to <file>.rejected with the line number and reason
+};
+
+enum ImportColumn { ImportID, ImportName, ImportContact, ImportEmail, ImportDate, ImportSlot, ImportTable, ImportTableCount, ImportParty, ImportColumnCount };
+
+struct ImportRow{ // One line of a bulk import once the parallel stage has parsed and checked it
+    long long lineNumber = 0;
+    string line;
+    array<string, ImportColumnCount> values;
+    BookingResult result = BookingOk;
+};
+
+// Parallel stage of a bulk import: splits each batch of rows across the pool, parses them, runs the field
+// checks, and resolves repeated customer IDs by earliest line so the outcome never depends on thread timing.
+class BulkValidator{
+private:
+    WorkStealingPool &pool;
+    bool isJson;
+    int columnAt[ImportColumnCount];
+    int firstBookableDay;
+    ShardedFirstRow firstRows; // For the whole file, so repeats across batches are caught too
+
+    static unsigned int detailsHash(const ImportRow &row){ // FNV-1a over name, contact and email
+        unsigned int hash = 2166136261u;
+        for (int column = ImportName; column <= ImportEmail; column++){
+            for (char c : row.values[column]){
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            hash = (hash ^ 0xFFu) * 16777619u;
+        }
+        return hash;
+    }
+
+    static string detailsOf(const ImportRow &row){ // Name, contact and email; the checked fields never hold a newline
+        return row.values[ImportName] + '\n' + row.values[ImportContact] + '\n' + row.values[ImportEmail];
+    }
+
+    void parse(ImportRow &row, vector<string> &fields) const{
+        if (isJson){
+            for (int column = 0; column < ImportColumnCount; column++){
+                if (!jsonField(row.line, columnName(column), row.values[column])){
+                    row.values[column].clear();
+                }
+            }
+            return;
+        }
+        if (!splitCsvLine(row.line, fields)){
+            row.result = InvalidCustomerID;
+            return;
+        }
+        for (int column = 0; column < ImportColumnCount; column++){
+            if (columnAt[column] >= 0 && columnAt[column] < static_cast<int>(fields.size())){
+                row.values[column].swap(fields[columnAt[column]]);
+            } else{
+                row.values[column].clear();
+            }
+        }
+    }
+
+    BookingResult checkFields(const ImportRow &row) const{ // Every rule that needs no shared state
+        const string &id = row.values[ImportID];
+        const string &date = row.values[ImportDate];
+        int slot = atoi(row.values[ImportSlot].c_str());
+        int partySize = atoi(row.values[ImportParty].c_str());
+
+        const FieldKernels &kernels = fieldKernels();
+        bool isContactAndDateOk = kernels.contactAndDate(row.values[ImportContact], date); // One vector pass for both
+
+        if (id.empty() || id.length() >= sizeof(CustomerRecord::customerID)){
+            return InvalidCustomerID;
+        } else if (!kernels.customerName(row.values[ImportName])){
+            return InvalidCustomerName;
+        } else if (!isContactAndDateOk && !isValidContactInput(row.values[ImportContact])){
+            return InvalidContact;
+        } else if (!isValidEmail(row.values[ImportEmail])){
+            return InvalidEmail;
+        } else if (!isContactAndDateOk){
+            return InvalidDateFormat;
+        } else if (dateToDayNumber(date) < firstBookableDay){
+            return DateNotAvailable;
+        } else if (slot < 1 || slot > Reservation::totalSlots){
+            return InvalidSlot;
+        } else if (row.values[ImportTable].empty() && partySize < 1){
+            return InvalidTable;
+        } else if (!row.values[ImportTable].empty()){
+            int tableCount = row.values[ImportTableCount].empty() ? 1 : atoi(row.values[ImportTableCount].c_str());
+            if (TableArea::seatsAt(atoi(row.values[ImportTable].c_str()), tableCount) < max(partySize, 1)){
+                return TableArea::seatsAt(atoi(row.values[ImportTable].c_str()), tableCount) == 0 ? InvalidTable : TableTooSmall;
+            }
+        }
+        return BookingOk;
+    }
+
+public:
+    BulkValidator(WorkStealingPool &pool, bool isJson, int firstBookableDay) : pool(pool), isJson(isJson), firstBookableDay(firstBookableDay){
+        fill(columnAt, columnAt + ImportColumnCount, -1);
+    }
+
+    static const char *columnName(int column){
+        static const char *names[] = {"customerID", "name", "contact", "email", "date", "slot", "table", "tableCount", "party"};
+        return names[column];
+    }
+
+    bool needsHeader() const { return !isJson && columnAt[ImportID] < 0; }
+
+    bool readHeader(const string &line){ // CSV only; false if no column is named customerID
+        vector<string> fields;
+        splitCsvLine(line, fields);
+        for (size_t i = 0; i < fields.size(); i++){
+            for (int column = 0; column < ImportColumnCount; column++){
+                if (fields[i] == columnName(column)){
+                    columnAt[column] = static_cast<int>(i);
+                }
+            }
+        }
+        return columnAt[ImportID] >= 0;
+    }
+
+    void validate(vector<ImportRow> &rows, size_t count){ // Sets result on rows[0, count)
+        METRIC_SCOPE(MetricValidateBatch);
+        pool.parallelFor(count, 512, [&](size_t begin, size_t end){
+            vector<string> fields;
+            for (size_t i = begin; i < end; i++){
+                ImportRow &row = rows[i];
+                row.result = BookingOk;
+                parse(row, fields);
+                if (row.result == BookingOk){
+                    row.result = checkFields(row);
+                }
+                if (row.result == BookingOk){
+                    firstRows.offer(row.values[ImportID], row.lineNumber, detailsHash(row), [&](){ return detailsOf(row); });
+                }
+            }
+        });
+
+        // Once every offer is in: a later row may repeat an ID only with the same name, contact and email
+        pool.parallelFor(count, 512, [&](size_t begin, size_t end){
+            for (size_t i = begin; i < end; i++){
+                ImportRow &row = rows[i];
+                if (row.result == BookingOk && firstRows.differsFromFirst(row.values[ImportID], row.lineNumber, detailsHash(row),
+                                                                              [&](const string &details){ return details == detailsOf(row); })){
+                    row.result = DuplicateCustomerID;
+                }
+            }
+        });
+    }
+};
+
+class SessionArena : public pmr::memory_resource{ // Bump allocator over a session's inline buffer, overflow goes to the heap
+private:
+    unsigned char *buffer;
+    unsigned short capacity;
+    unsigned short top = 0;  // First free byte
+    unsigned short live = 0; // Blocks handed out from the buffer and not yet returned
+
+    bool owns(const void *memory) const {
+        const unsigned char *byte = static_cast<const unsigned char *>(memory);
+        return byte >= buffer && byte < buffer + capacity;
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        size_t start = (top + alignment - 1) & ~(alignment - 1);
+        if (start + bytes <= capacity){
+            top = static_cast<unsigned short>(start + bytes);
+            live++;
+            return buffer + start;
+        }
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *memory, size_t bytes, size_t alignment) override {
+        if (!owns(memory)){
+            pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+            return;
+        }
+        unsigned char *byte = static_cast<unsigned char *>(memory);
+        if (--live == 0){
+            top = 0; // Everything returned, the whole buffer is free again
+        } else if (byte + bytes == buffer + top){
+            top = static_cast<unsigned short>(byte - buffer); // Last block returned, give its bytes back
+        }
+    }
+
+    bool do_is_equal(const pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+public:
+    SessionArena(unsigned char *buffer, size_t capacity) : buffer(buffer), capacity(static_cast<unsigned short>(capacity)) {}
+    SessionArena(const SessionArena &) = delete;
+    SessionArena &operator=(const SessionArena &) = delete;
+};
+
+// Per-client reservation state; BookingEngine holds everything shared. The order lists are carved from an
+// arena inside the session, so a session with a few dishes never reaches the heap; space freed by the lists
+// is reused, and longer lists spill to the heap and are freed with them.
+struct ReservationSession{
+private:
+    alignas(max_align_t) unsigned char arenaBuffer[96]; // Room for both lists to grow to four entries
+    SessionArena arena{arenaBuffer, sizeof(arenaBuffer)};
+
+public:
+    Customer customer;                 // To store customer details
+    long long bookingIndex = -1;       // Record index of the current reservation in bookings.dat
+    string reservationDate;
+    int reservationSlot = -1;          // Initially, no slot selected
+    int reservedTable = -1;            // Initially, no table selected
+    int reservedTableCount = 1;        // Adjacent tables joined from reservedTable on
+    int partySize = 0;
+    pmr::vector<pair<int, int>> menuOrders{&arena}; // Stores menu item ID and quantity
+    pmr::vector<int> orders{&arena};                // Store ordered item IDs
+    bool reservationWithMenu = false;
+    bool isPaid = false;
+
+    ReservationSession() {}
+
+    ReservationSession(const ReservationSession &other) // The copy's lists live in its own arena
+        : customer(other.customer), bookingIndex(other.bookingIndex), reservationDate(other.reservationDate),
+          reservationSlot(other.reservationSlot), reservedTable(other.reservedTable), reservedTableCount(other.reservedTableCount),
+          partySize(other.partySize), menuOrders(other.menuOrders.begin(), other.menuOrders.end(), &arena),
+          orders(other.orders.begin(), other.orders.end(), &arena), reservationWithMenu(other.reservationWithMenu), isPaid(other.isPaid) {}
+
+    ReservationSession &operator=(const ReservationSession &other){
+        if (this == &other){
+            return *this;
+        }
+        customer = other.customer;
+        bookingIndex = other.bookingIndex;
+        reservationDate = other.reservationDate;
+        reservationSlot = other.reservationSlot;
+        reservedTable = other.reservedTable;
+        reservedTableCount = other.reservedTableCount;
+        partySize = other.partySize;
+        reservationWithMenu = other.reservationWithMenu;
+        isPaid = other.isPaid;
+
+        clearOrders(); // Start the arena empty so the copies pack from its first byte
+        menuOrders.assign(other.menuOrders.begin(), other.menuOrders.end());
+        orders.assign(other.orders.begin(), other.orders.end());
+        return *this;
+    }
+
+    void clearOrders(){ // Empties both lists and hands their storage back
+        pmr::vector<pair<int, int>>(&arena).swap(menuOrders);
+        pmr::vector<int>(&arena).swap(orders);
+    }
+};
+
+class BookingEngine{ // Reserve, modify, order, pay, cancel and query with no console I/O; shared by all sessions
+private:
+    Reservation reservation;                         // To handle reservation slots and tables
+    TableInventory tables;                           // Seat buckets for table search
+    ReservationStore store;                          // customers.dat, bookings.dat, orders.dat and their log
+    BillingEngine billing;                           // Order pricing
+    KitchenQueue kitchen;                            // Orders of confirmed reservations, by slot and station
+    vector<Customer> customers;                      // Customers registered since startup
+    unordered_map<string, size_t> customerPositions; // Customer ID -> index in customers
+    unordered_map<string, size_t> customerIndex;     // Customer ID -> record index in store.customers
+    mutex customersMutex;                            // Guards customers, customerPositions and customerIndex
+    Waitlist waitlist;                               // Parties waiting for a full slot
+    unordered_map<string, Promotion> promotions;     // Customer ID -> booking made off the waitlist, not yet claimed
+    mutex waitlistMutex;                             // Guards waitlist and promotions
+
+    void queueKitchenOrders(const ReservationSession &session, int sign){ // +1 sends the session's orders to the kitchen, -1 takes them back
+        if (session.bookingIndex < 0){
+            return;
+        }
+        int dayNumber = dateToDayNumber(session.reservationDate);
+        for (const auto &item : session.menuOrders){
+            kitchen.push(KitchenTicket{dayNumber, session.reservationSlot, item.first, sign * item.second});
+        }
+    }
+
+    // Payment or cancellation; false if the log did not take it
+    bool logBookingChange(const string &customerID, long long bookingIndex, LogEventType type){
+        LogRecord event = {};
+        event.type = type;
+        copyField(event.customer.customerID, customerID);
+        event.bookingIndex = static_cast<int>(bookingIndex);
+        return store.commit(event) >= 0;
+    }
+
+    bool commitBookingChange(ReservationSession &session, LogEventType type){ // False if the change could not be logged
+        if (session.bookingIndex < 0){
+            return false;
+        }
+        return logBookingChange(session.customer.getCustomerID(), session.bookingIndex, type);
+    }
+
+    long long logBooking(const string &customerID, int dayNumber, int slot, int table, int tableCount){ // slot is 1-based
+        LogRecord event = {};
+        event.type = LogBooking;
+        copyField(event.customer.customerID, customerID);
+        event.dayNumber = dayNumber;
+        event.slot = slot - 1;
+        event.table = table;
+        event.quantity = tableCount;
+        return store.commit(event);
+    }
+
+    // Logs a booking for tables the caller has already claimed; if the log will not take it, the claim is given back
+    BookingResult commitBooking(ReservationSession &session, const string &date, int slot, int table, int tableCount = 1){
+        long long bookingIndex = logBooking(session.customer.getCustomerID(), dateToDayNumber(date), slot, table, tableCount);
+        if (bookingIndex < 0){
+            reservation.releaseSlot(date, slot - 1, table, tableCount);
+            return StorageError;
+        }
+
+        session.bookingIndex = bookingIndex;
+        session.reservationDate = date;
+        session.reservationSlot = slot;
+        session.reservedTable = table;
+        session.reservedTableCount = tableCount;
+        queueKitchenOrders(session, 1); // Dishes ordered before booking, as claimPromotion does for a waiter
+        return BookingOk;
+    }
+
+    // Seats waiters in a slot (0-based) whose capacity was just freed, longest-waiting eligible party first,
+    // until nobody left in line fits. Returns the guests seated.
+    int promoteWaiters(int dayNumber, int slot){
+        lock_guard<mutex> lock(waitlistMutex);
+        string date = dayNumberToDate(dayNumber);
+        int seatedGuests = 0;
+        Waiter waiter;
+        vector<Waiter> skipped; // Put back once the loop ends, or next() would hand them out again
+        while (waitlist.next(dayNumber, slot, tables.largestFreeGroup(Reservation::takenTables(reservation.getSlots(dayNumber), slot)), waiter)){
+            if (promotions.count(waiter.customerID)){ // Still holds a booking nobody has picked up: one at a time
+                skipped.push_back(waiter);
+                continue;
+            }
+            TableGroup group;
+            if (!tables.bestFit(Reservation::takenTables(reservation.getSlots(dayNumber), slot), waiter.partySize, group) ||
+                reservation.reserveSlot(date, slot, group.firstTable, group.tableCount) != BookingOk){
+                waitlist.requeue(dayNumber, slot, waiter); // A live session took the tables first
+                break;
+            }
+            long long bookingIndex = logBooking(waiter.customerID, dayNumber, slot + 1, group.firstTable, group.tableCount);
+            if (bookingIndex < 0){
+                reservation.releaseSlot(date, slot, group.firstTable, group.tableCount);
+                waitlist.requeue(dayNumber, slot, waiter);
+                break;
+            }
+            promotions[waiter.customerID] = Promotion{bookingIndex, dayNumber, slot + 1, group.firstTable, group.tableCount, waiter.partySize};
+            seatedGuests += waiter.partySize;
+        }
+        for (const Waiter &kept : skipped){
+            waitlist.requeue(dayNumber, slot, kept);
+        }
+        return seatedGuests;
+    }
+
+public:
+    explicit BookingEngine(const string &dataPrefix = "") : store(dataPrefix) {}
+    BookingEngine(const BookingEngine &) = delete;
+    BookingEngine &operator=(const BookingEngine &) = delete;
+
+    bool open(){ // Maps the stores, replays the log and rebuilds the customer index, ID set and booked slots
+        if (!store.open()){
+            return false;
+        }
+
+        for (size_t i = 0; i < store.customers.size(); i++){
+            string id = fieldToString(store.customers.at(i).customerID);
+            customerIndex[id] = i;
+            Customer::registerID(id);
+        }
+
+        for (size_t i = 0; i < store.bookings.size(); i++){
+            const BookingRecord &booking = store.bookings.at(i);
+            if (booking.status != BookingCancelled){
+                reservation.restoreSlot(booking.dayNumber, booking.slot, booking.table, booking.tableCount);
+            }
+        }
+        return true;
+    }
+
+    void setFsyncPolicy(FsyncPolicy policy){ store.setFsyncPolicy(policy); }
+    void commitPending(){ store.sync(); } // Group commit point
+    void shutdown(){ store.checkpoint(); }
+
+    // Queries
+
+    BookingResult checkDate(const string &date){ // Format, not in the past, and bookable
+        METRIC_SCOPE(MetricCheckDate);
+        if (!isValidDateFormat(date)){
+            return InvalidDateFormat;
+        }
+        return reservation.checkIfValidDate(date) ? BookingOk : DateNotAvailable;
+    }
+
+    unsigned long long availability(const string &date) const{ // Day word: Reservation::takenTables gives each slot's tables
+        return isValidDate(date) ? reservation.getSlots(date) : 0;
+    }
+
+    bool isSlotFull(unsigned long long dayWord, int slot) const{ // slot is 1-based
+        return (Reservation::takenTables(dayWord, slot - 1) & tables.tableMask()) == tables.tableMask();
+    }
+
+    bool findSeating(const string &date, int slot, int partySize, TableGroup &found) const{ // Best-fit tables for the party
+        if (!isValidDate(date) || slot < 1 || slot > Reservation::totalSlots || partySize < 1){
+            return false;
+        }
+        return tables.bestFit(Reservation::takenTables(reservation.getSlots(date), slot - 1), partySize, found);
+    }
+
+    bool findNextSeating(const string &fromDate, int numDays, int partySize, string &foundDate, int &foundSlot) const{ // foundSlot is 1-based
+        int day;
+        unsigned int slots;
+        if (firstOpenDates(fromDate, numDays, max(partySize, 1), 1, &day, &slots) == 0){
+            return false;
+        }
+        foundDate = dayNumberToDate(day);
+        foundSlot = lowestSetBit(slots) + 1;
+        return true;
+    }
+
+    // Free slots per day for the party over numDays days (partySize 0: any free table). Read-only and
+    // allocation-free; returns the number of days written to freeSlots, 0 for a bad date.
+    int freeSlotsPerDay(const string &fromDate, int numDays, int partySize, unsigned char *freeSlots) const{
+        METRIC_SCOPE(MetricRangeQuery);
+        if (!isValidDate(fromDate) || numDays < 1){
+            return 0;
+        }
+        tables.freeSlotsPerDay(reservation, dateToDayNumber(fromDate), numDays, partySize, freeSlots);
+        return numDays;
+    }
+
+    // First maxDates dates within numDays of fromDate with a slot for the party; slotMasks bit s-1 = slot s open
+    int firstOpenDates(const string &fromDate, int numDays, int partySize, int maxDates, int *dayNumbers, unsigned int *slotMasks) const{
+        METRIC_SCOPE(MetricRangeQuery);
+        if (!isValidDate(fromDate) || numDays < 1){
+            return 0;
+        }
+        return tables.firstOpenDates(reservation, dateToDayNumber(fromDate), numDays, partySize, maxDates, dayNumbers, slotMasks);
+    }
+
+    // Next date and slot (1-based) with a free table; table 0 means any table
+    bool findNextFreeSlot(const string &fromDate, int numDays, int table, string &foundDate, int &foundSlot) const{
+        unsigned int wanted = table > 0 ? 1u << (table - 1) : tables.tableMask();
+        if (!isValidDate(fromDate) || !reservation.findFirstFreeSlot(fromDate, numDays, wanted, foundDate, foundSlot)){
+            return false;
+        }
+        foundSlot++;
+        return true;
+    }
+
+    bool findCustomer(const string &id, Customer &found){
+        METRIC_SCOPE(MetricFindCustomer);
+        lock_guard<mutex> lock(customersMutex);
+        // First, check in memory
+        auto position = customerPositions.find(id);
+        if (position != customerPositions.end()){
+            found = customers[position->second];
+            return true;
+        }
+
+        // Then, read only the matching record from the file through the index
+        auto stored = customerIndex.find(id);
+        if (stored != customerIndex.end()){
+            found = Customer::fromRecord(store.customerAt(stored->second));
+            return true;
+        }
+        return false;
+    }
+
+    vector<Customer> registeredCustomers(){ // Copies, so callers can print without holding the lock
+        lock_guard<mutex> lock(customersMutex);
+        return customers;
+    }
+
+    // Commands
+
+    BookingResult registerCustomer(ReservationSession &session, const Customer &newCustomer){
+        METRIC_SCOPE(MetricRegister);
+        const string &id = newCustomer.getCustomerID();
+        if (newCustomer.isTooLong(Customer::NameTooLong) || !isValidCustomerName(newCustomer.getCustomerName())){
+            return InvalidCustomerName;
+        }
+        if (id.empty() || newCustomer.isTooLong(Customer::IDTooLong)){
+            return InvalidCustomerID;
+        }
+        if (newCustomer.isTooLong(Customer::ContactTooLong) || !isValidContactInput(newCustomer.getContactNumber())){
+            return InvalidContact;
+        }
+        if (newCustomer.isTooLong(Customer::EmailTooLong) || !isValidEmail(newCustomer.getCustomerEmail())){
+            return InvalidEmail;
+        }
+        if (!Customer::registerID(id)){ // Claims the ID in the same step as the check
+            return DuplicateCustomerID;
+        }
+
+        long long recordIndex = newCustomer.saveToFile(store);
+        if (recordIndex < 0){ // Nothing was stored, so a retry must find the ID free
+            Customer::releaseID(id);
+            return StorageError;
+        }
+        {
+            lock_guard<mutex> lock(customersMutex);
+            customerIndex[id] = recordIndex; // Keep the index in step with the append
+            customerPositions[id] = customers.size();
+            customers.push_back(newCustomer); // Store the new customer in the customers vector
+        }
+
+        session = ReservationSession(); // A new customer starts a new reservation
+        session.customer = newCustomer;
+        return BookingOk;
+    }
+
+    // slot 1-5, table 1-10; partySize 0 skips the seating check
+    BookingResult reserve(ReservationSession &session, const string &date, int slot, int table, int partySize = 0){
+        METRIC_SCOPE(MetricReserve);
+        if (session.bookingIndex >= 0){ // A second booking would leave the first one's tables with no session
+            return AlreadyBooked;
+        }
+        BookingResult dateResult = checkDate(date);
+        if (dateResult != BookingOk){
+            return dateResult;
+        }
+        if (!TableArea::isValidTable(table)){
+            return InvalidTable;
+        }
+        if (TableArea::seatsAt(table) < partySize){
+            return TableTooSmall;
+        }
+
+        BookingResult slotResult = reservation.reserveSlot(date, slot - 1, table);
+        if (slotResult != BookingOk){
+            return slotResult;
+        }
+        session.partySize = partySize;
+        return commitBooking(session, date, slot, table);
+    }
+
+    // Seats the party at the best-fit table or joined tables for the slot; retries if another session wins the race
+    BookingResult seatParty(ReservationSession &session, const string &date, int slot, int partySize){
+        METRIC_SCOPE(MetricSeatParty);
+        if (session.bookingIndex >= 0){ // Same as reserve: cancel or move the booking the session holds
+            return AlreadyBooked;
+        }
+        BookingResult dateResult = checkDate(date);
+        if (dateResult != BookingOk){
+            return dateResult;
+        }
+        if (slot < 1 || slot > Reservation::totalSlots){
+            return InvalidSlot;
+        }
+
+        TableGroup group;
+        while (findSeating(date, slot, partySize, group)){
+            if (reservation.reserveSlot(date, slot - 1, group.firstTable, group.tableCount) == BookingOk){
+                session.partySize = partySize;
+                return commitBooking(session, date, slot, group.firstTable, group.tableCount);
+            }
+        }
+        return partySize > TableArea::largestParty() ? TableTooSmall : SlotTaken;
+    }
+
+    // Moves the booking to a new date, slot (1-based) and tables as one step. The new tables are taken before
+    // anything is given up, a single LogMove record switches the booking over, and the old tables are freed
+    // only after that commit; any failure releases what was taken and leaves the old booking untouched.
+    // table 0 seats the party at the best fit for the new slot, counting the booking's own tables as free.
+    BookingResult move(ReservationSession &session, const string &date, int slot, int table, int tableCount = 1, int partySize = 0){
+        METRIC_SCOPE(MetricMove);
+        if (session.bookingIndex < 0){ // Nothing to move: book as new
+            return table == 0 ? seatParty(session, date, slot, max(partySize, 1)) : reserve(session, date, slot, table, partySize);
+        }
+        BookingResult dateResult = checkDate(date);
+        if (dateResult != BookingOk){
+            return dateResult;
+        }
+        if (slot < 1 || slot > Reservation::totalSlots){
+            return InvalidSlot;
+        }
+        if (partySize < 1){
+            partySize = session.partySize;
+        }
+
+        int newDay = dateToDayNumber(date);
+        int oldDay = dateToDayNumber(session.reservationDate);
+        int oldSlot = session.reservationSlot - 1;
+        unsigned int oldTables = Reservation::heldTables(session.reservedTable, session.reservedTableCount);
+        unsigned int ownTables = newDay == oldDay && slot - 1 == oldSlot ? oldTables : 0; // Already ours in the new slot
+
+        TableGroup group;
+        if (table != 0){
+            group.tables = Reservation::tableRun(table, tableCount);
+            group.firstTable = table;
+            group.tableCount = tableCount;
+            if (!group.tables || TableArea::seatsAt(table, tableCount) == 0){
+                return InvalidTable;
+            }
+            if (TableArea::seatsAt(table, tableCount) < partySize){
+                return TableTooSmall;
+            }
+        }
+
+        unsigned int toTake;
+        while (true){
+            if (table == 0){
+                unsigned int taken = Reservation::takenTables(reservation.getSlots(newDay), slot - 1) & ~ownTables;
+                if (!tables.bestFit(taken, max(partySize, 1), group)){
+                    return partySize > TableArea::largestParty() ? TableTooSmall : SlotTaken;
+                }
+            }
+            toTake = group.tables & ~ownTables;
+            if (!toTake || reservation.reserveTables(newDay, slot - 1, toTake)){
+                break;
+            }
+            if (table != 0){
+                return SlotTaken;
+            }
+            // Best fit lost a race to another session: look again
+        }
+
+        LogRecord event = {};
+        event.type = LogMove;
+        copyField(event.customer.customerID, session.customer.getCustomerID());
+        event.bookingIndex = static_cast<int>(session.bookingIndex);
+        event.dayNumber = newDay;
+        event.slot = slot - 1;
+        event.table = group.firstTable;
+        event.quantity = group.tableCount;
+        if (store.commit(event) < 0){ // Roll back: the old booking still holds its tables
+            if (toTake){
+                reservation.releaseTables(newDay, slot - 1, toTake);
+            }
+            return StorageError;
+        }
+
+        unsigned int toFree = oldTables & ~(ownTables ? group.tables : 0);
+        if (toFree){
+            reservation.releaseTables(oldDay, oldSlot, toFree);
+        }
+        bool isNewSlot = !ownTables;
+        if (isNewSlot){
+            queueKitchenOrders(session, -1);
+        }
+        session.reservationDate = date;
+        session.reservationSlot = slot;
+        session.reservedTable = group.firstTable;
+        session.reservedTableCount = group.tableCount;
+        session.partySize = partySize;
+        if (isNewSlot){
+            queueKitchenOrders(session, 1);
+        }
+        if (toFree){
+            promoteWaiters(oldDay, oldSlot);
+        }
+        return BookingOk;
+    }
+
+    BookingResult modify(ReservationSession &session, const string &date, int slot){ // New date and slot, same tables
+        if (session.bookingIndex < 0 || session.reservedTable < 1){
+            return InvalidTable;
+        }
+        return move(session, date, slot, session.reservedTable, session.reservedTableCount);
+    }
+
+    // Another table in the same slot; table 0 picks the best fit for the party. Before booking it only records the choice.
+    BookingResult changeTable(ReservationSession &session, int table, int partySize = 0){
+        if (session.bookingIndex < 0){
+            if (!TableArea::isValidTable(table)){
+                return InvalidTable;
+            }
+            if (TableArea::seatsAt(table) < partySize){
+                return TableTooSmall;
+            }
+            session.reservedTable = table;
+            session.reservedTableCount = 1;
+            session.partySize = max(partySize, session.partySize);
+            return BookingOk;
+        }
+        return move(session, session.reservationDate, session.reservationSlot, table, 1, partySize);
+    }
+
+    BookingResult order(ReservationSession &session, int menuID, int quantity = 1){
+        METRIC_SCOPE(MetricOrder);
+        if (!MenuCatalog::instance().contains(menuID) || quantity < 1){
+            return InvalidMenuItem;
+        }
+
+        LogRecord event = {};
+        event.type = LogOrder;
+        copyField(event.customer.customerID, session.customer.getCustomerID());
+        event.menuID = menuID;
+        event.quantity = quantity;
+        if (store.commit(event) < 0){
+            return StorageError; // The session keeps only logged orders
+        }
+
+        session.orders.push_back(menuID); // Add the item to the orders list
+        auto existing = find_if(session.menuOrders.begin(), session.menuOrders.end(), [&](const pair<int, int> &item){ return item.first == menuID; });
+        if (existing == session.menuOrders.end()){
+            session.menuOrders.push_back(make_pair(menuID, quantity));
+        } else{
+            existing->second += quantity;
+        }
+        session.reservationWithMenu = true;
+        if (session.bookingIndex >= 0){
+            kitchen.push(KitchenTicket{dateToDayNumber(session.reservationDate), session.reservationSlot, menuID, quantity});
+        }
+        return BookingOk;
+    }
+
+    // Dish batches for a slot (1-based); firing takes them off the kitchen board
+    vector<KitchenBatch> kitchenBatches(const string &date, int slot, bool isFiring){
+        if (!isValidDate(date)){
+            return vector<KitchenBatch>();
+        }
+        return isFiring ? kitchen.fire(dateToDayNumber(date), slot) : kitchen.batches(dateToDayNumber(date), slot);
+    }
+
+    Bill bill(const ReservationSession &session, int discountBasisPoints = 0) const{ // Reservation fee plus the session's orders
+        return billing.price(session.menuOrders, session.bookingIndex >= 0 ? 1 : 0, discountBasisPoints);
+    }
+
+    long long amountDue(const ReservationSession &session) const{ // Centavos
+        return bill(session).total;
+    }
+
+    // Prices everything on file: one bill per customer, with the orders of bookings not cancelled and a fee per booking.
+    // Meant for the end-of-day run, not while sessions are committing.
+    BillingTotals priceAllOrders(){
+        unordered_map<string, size_t> billIndex; // Customer ID -> position in orderLines and bookingCounts
+        vector<vector<pair<int, int>>> orderLines;
+        vector<int> bookingCounts;
+        auto billFor = [&](const string &id){
+            auto found = billIndex.find(id);
+            if (found != billIndex.end()){
+                return found->second;
+            }
+            orderLines.emplace_back();
+            bookingCounts.push_back(0);
+            return billIndex[id] = orderLines.size() - 1;
+        };
+
+        for (size_t i = 0; i < store.orders.size(); i++){ // Reversals logged by cancel carry a negative quantity and net out here
+            const OrderRecord &order = store.orders.at(i);
+            vector<pair<int, int>> &lines = orderLines[billFor(fieldToString(order.customerID))];
+            auto existing = find_if(lines.begin(), lines.end(), [&](const pair<int, int> &line){ return line.first == order.menuID; });
+            if (existing == lines.end()){
+                lines.push_back(make_pair(order.menuID, order.quantity));
+            } else{
+                existing->second += order.quantity;
+            }
+        }
+        for (size_t i = 0; i < store.bookings.size(); i++){
+            const BookingRecord &booking = store.bookings.at(i);
+            if (booking.status != BookingCancelled){
+                bookingCounts[billFor(fieldToString(booking.customerID))]++;
+            }
+        }
+
+        BillingTotals totals;
+        for (size_t i = 0; i < orderLines.size(); i++){
+            BillingEngine::addTo(totals, billing.price(orderLines[i], bookingCounts[i]));
+        }
+        return totals;
+    }
+
+    BookingResult pay(ReservationSession &session, int paymentMethod, const string &reference){ // 1 = credit card, 2 = online payment
+        METRIC_SCOPE(MetricPay);
+        if (session.bookingIndex < 0){ // A waitlisted or cancelled session has nothing to pay for
+            return NoBooking;
+        }
+        if (session.isPaid){
+            return AlreadyPaid;
+        }
+        if (paymentMethod == 1 && (reference.length() < 13 || reference.length() > 19)){
+            return InvalidCardNumber;
+        }
+        if (paymentMethod == 2 && reference.empty()){
+            return InvalidTransactionID;
+        }
+        if (paymentMethod != 1 && paymentMethod != 2){
+            return InvalidPaymentMethod;
+        }
+
+        if (!commitBookingChange(session, LogPayment)){
+            return StorageError; // Still unpaid
+        }
+        session.isPaid = true; // Mark payment as completed
+        return BookingOk;
+    }
+
+    // Puts the party in line for the slot. The line is served right away, so a party that fits now (or tables
+    // freed while joining) comes back as BookingOk with the session booked, otherwise as Waitlisted.
+    BookingResult joinWaitlist(ReservationSession &session, const string &date, int slot, int partySize){
+        METRIC_SCOPE(MetricWaitlist);
+        if (session.bookingIndex >= 0){
+            return AlreadyBooked;
+        }
+        BookingResult dateResult = checkDate(date);
+        if (dateResult != BookingOk){
+            return dateResult;
+        }
+        if (slot < 1 || slot > Reservation::totalSlots){
+            return InvalidSlot;
+        }
+        if (partySize < 1 || partySize > TableArea::largestParty()){
+            return TableTooSmall;
+        }
+
+        {
+            lock_guard<mutex> lock(waitlistMutex);
+            const string &id = session.customer.getCustomerID();
+            if (promotions.count(id)){ // Booked off the waitlist already; the session has not picked it up yet
+                return AlreadyBooked;
+            }
+            if (waitlist.contains(id)){
+                return AlreadyWaitlisted;
+            }
+            waitlist.add(dateToDayNumber(date), slot - 1, id, partySize);
+        }
+        promoteWaiters(dateToDayNumber(date), slot - 1);
+        return claimPromotion(session) ? BookingOk : Waitlisted;
+    }
+
+    // Moves a booking made off the waitlist into the customer's session. A session that booked on its own in the
+    // meantime keeps that booking, and the promoted one is cancelled so its tables go to the next party in line.
+    bool claimPromotion(ReservationSession &session){
+        unique_lock<mutex> lock(waitlistMutex);
+        auto it = promotions.find(session.customer.getCustomerID());
+        if (it == promotions.end()){
+            return false;
+        }
+        const Promotion &promotion = it->second;
+        if (session.bookingIndex >= 0){
+            Promotion unwanted = promotion;
+            if (!logBookingChange(session.customer.getCustomerID(), unwanted.bookingIndex, LogCancel)){
+                return false; // Stays promoted; the booking is still on file
+            }
+            promotions.erase(it);
+            lock.unlock();
+            reservation.releaseTables(unwanted.dayNumber, unwanted.slot - 1, Reservation::heldTables(unwanted.table, unwanted.tableCount));
+            promoteWaiters(unwanted.dayNumber, unwanted.slot - 1);
+            return false;
+        }
+        session.bookingIndex = promotion.bookingIndex;
+        session.reservationDate = dayNumberToDate(promotion.dayNumber);
+        session.reservationSlot = promotion.slot;
+        session.reservedTable = promotion.table;
+        session.reservedTableCount = promotion.tableCount;
+        session.partySize = promotion.partySize;
+        promotions.erase(it);
+        queueKitchenOrders(session, 1); // Anything ordered while waiting goes to the kitchen now
+        return true;
+    }
+
+    size_t waitingParties(){
+        lock_guard<mutex> lock(waitlistMutex);
+        return waitlist.size();
+    }
+
+    // Frees the tables and hands them to the waitlist. Nothing is freed unless the cancel is logged first:
+    // otherwise a replay would bring the booking back over whoever got its tables.
+    BookingResult cancel(ReservationSession &session){
+        METRIC_SCOPE(MetricCancel);
+        if (session.bookingIndex >= 0){
+            vector<LogRecord> events(1); // The cancel, then a reversal of each dish so the day's billing drops them
+            events[0].type = LogCancel;
+            copyField(events[0].customer.customerID, session.customer.getCustomerID());
+            events[0].bookingIndex = static_cast<int>(session.bookingIndex);
+            for (const pair<int, int> &item : session.menuOrders){
+                LogRecord reversal = {};
+                reversal.type = LogOrder;
+                reversal.customer = events[0].customer;
+                reversal.menuID = item.first;
+                reversal.quantity = -item.second;
+                events.push_back(reversal);
+            }
+            vector<long long> recordIndexes;
+            if (!store.commitBatch(events, recordIndexes)){
+                return StorageError; // The booking stands
+            }
+            queueKitchenOrders(session, -1);
+            int slot = session.reservationSlot - 1;
+            reservation.releaseSlot(session.reservationDate, slot, session.reservedTable, session.reservedTableCount);
+            promoteWaiters(dateToDayNumber(session.reservationDate), slot);
+        }
+        session.bookingIndex = -1;
+        session.reservationDate.clear();
+        session.reservationSlot = -1;
+        session.reservedTable = -1;
+        session.reservedTableCount = 1;
+        session.clearOrders();
+        session.reservationWithMenu = false;
+        session.isPaid = false; // Reset payment status
+        return BookingOk;
+    }
+
+    // Text format tools; these touch files only, never the console
+
+    int exportCustomersToText(const string &fileName){ // Writes the store in the customerss.txt text format, returns the count or -1
+        ofstream outFile(fileName);
+        if (!outFile.is_open()){
+            return -1;
+        }
+
+        for (size_t i = 0; i < store.customers.size(); i++){
+            const CustomerRecord &record = store.customers.at(i);
+            outFile << "Customer Details:" << '\n';
+            outFile << "Name: " << fieldToString(record.customerName) << '\n';
+            outFile << "Contact Number: " << fieldToString(record.contactNumber) << '\n';
+            outFile << "Email: " << fieldToString(record.customerEmail) << '\n';
+            outFile << "Customer ID: " << fieldToString(record.customerID) << '\n';
+            outFile << "-------------------------" << '\n';
+        }
+        return static_cast<int>(store.customers.size());
+    }
+
+    int importCustomersFromText(const string &fileName, int &skipped){ // Appends customers from the text format, skipping known IDs
+        ifstream inFile(fileName);
+        skipped = 0;
+        if (!inFile.is_open()){
+            return -1;
+        }
+
+        int imported = 0;
+        string line, name, contact, email, id;
+        while (getline(inFile, line)){
+            if (line.rfind("Name: ", 0) == 0){
+                name = line.substr(6);
+            } else if (line.rfind("Contact Number: ", 0) == 0){
+                contact = line.substr(16);
+            } else if (line.rfind("Email: ", 0) == 0){
+                email = line.substr(7);
+            } else if (line.rfind("Customer ID: ", 0) == 0){
+                id = line.substr(13);
+            } else if (line.rfind("-----", 0) == 0){ // End of one record
+                if (id.empty() || !Customer::registerID(id)){
+                    skipped++;
+                } else{
+                    long long recordIndex = Customer(name, contact, email, id).saveToFile(store);
+                    if (recordIndex >= 0){
+                        lock_guard<mutex> lock(customersMutex);
+                        customerIndex[id] = recordIndex;
+                        imported++;
+                    } else{
+                        Customer::releaseID(id);
+                    }
+                }
+                name.clear();
+                contact.clear();
+                email.clear();
+                id.clear();
+            }
+        }
+        store.checkpoint();
+        return imported;
+    }
+
+    // Bulk import of bookings from CSV (header row names the columns) or JSON Lines (.json/.jsonl).
+    // Columns: customerID, name, contact, email, date, slot, and table (with optional tableCount) or party.
+    // Rows are parsed and checked in parallel, then tables are claimed and batches committed in file order;
+    // returns false if the file cannot be read or the store cannot be written.
+    bool importReservations(const string &fileName, ImportReport &report, int threadCount = 0){
+        METRIC_SCOPE(MetricImport);
+        static const size_t batchRows = 65536;
+        static const size_t commitSize = 4096;
+
+        LineReader reader(fileName);
+        if (!reader.isOpen()){
+            return false;
+        }
+        report = ImportReport();
+        bool isJson = fileName.size() >= 5 && (fileName.compare(fileName.size() - 5, 5, ".json") == 0 ||
+                                               (fileName.size() >= 6 && fileName.compare(fileName.size() - 6, 6, ".jsonl") == 0));
+
+        WorkStealingPool pool(threadCount > 0 ? threadCount : max(1, static_cast<int>(thread::hardware_concurrency())));
+        BulkValidator validator(pool, isJson, todayDayNumber());
+
+        FILE *rejects = nullptr;
+        auto reject = [&](long long lineNumber, BookingResult reason, const string &line){
+            report.rejected++;
+            if (!rejects && !(rejects = fopen((fileName + ".rejected").c_str(), "wb"))){
+                return;
+            }
+            string entry = to_string(lineNumber) + "," + csvField(describeResult(reason)) + "," + csvField(line) + "\n";
+            fwrite(entry.data(), 1, entry.size(), rejects);
+        };
+
+        vector<LogRecord> batch;
+        vector<long long> recordIndexes;
+        vector<string> batchCustomerIDs; // ID of each customer event in batch, in order
+        batch.reserve(commitSize * 2);
+        auto flush = [&](){
+            if (batch.empty()){
+                return true;
+            }
+            if (!store.commitBatch(batch, recordIndexes)){
+                size_t customerEvent = 0; // Nothing reached the store, so give back what the batch claimed
+                for (const LogRecord &event : batch){
+                    if (event.type == LogCustomer){
+                        Customer::releaseID(batchCustomerIDs[customerEvent++]);
+                        report.newCustomers--;
+                    } else{
+                        reservation.releaseSlot(dayNumberToDate(event.dayNumber), event.slot, event.table, event.quantity);
+                        report.imported--;
+                    }
+                }
+                batch.clear();
+                batchCustomerIDs.clear();
+                return false;
+            }
+            lock_guard<mutex> lock(customersMutex);
+            size_t customerEvent = 0;
+            for (size_t i = 0; i < batch.size(); i++){
+                if (batch[i].type == LogCustomer && recordIndexes[i] >= 0){
+                    customerIndex[batchCustomerIDs[customerEvent]] = recordIndexes[i];
+                }
+                customerEvent += batch[i].type == LogCustomer ? 1 : 0;
+            }
+            batch.clear();
+            batchCustomerIDs.clear();
+            return true;
+        };
+
+        vector<ImportRow> rows(batchRows);
+        long long lineNumber = 0;
+        bool isStorageOk = true, isEndOfFile = false;
+        while (isStorageOk && !isEndOfFile){
+            size_t count = 0;
+            while (count < batchRows && !(isEndOfFile = !reader.nextLine(rows[count].line))){
+                ImportRow &row = rows[count];
+                row.lineNumber = ++lineNumber;
+                if (row.line.empty() || (isJson && row.line[0] != '{')){
+                    continue; // Blank lines, and the brackets of a one-object-per-line JSON array
+                }
+                if (validator.needsHeader()){
+                    if (!validator.readHeader(row.line)){
+                        reject(row.lineNumber, InvalidCustomerID, row.line);
+                        isEndOfFile = true; // Without a header naming customerID no row can be read
+                        break;
+                    }
+                    continue;
+                }
+                count++;
+            }
+            validator.validate(rows, count);
+            report.rows += count;
+
+            for (size_t i = 0; i < count && isStorageOk; i++){ // Tables and IDs are claimed in file order
+                ImportRow &row = rows[i];
+                const string &id = row.values[ImportID];
+                const string &date = row.values[ImportDate];
+                int slot = atoi(row.values[ImportSlot].c_str());
+                Customer stored;
+                if (row.result == BookingOk && findCustomer(id, stored) &&
+                    (stored.getCustomerName() != row.values[ImportName] || stored.getContactNumber() != row.values[ImportContact] ||
+                     stored.getCustomerEmail() != row.values[ImportEmail])){
+                    row.result = DuplicateCustomerID; // A known ID only takes rows with the details it was stored with
+                }
+                TableGroup group;
+                if (row.result == BookingOk && !row.values[ImportTable].empty()){
+                    group.firstTable = atoi(row.values[ImportTable].c_str());
+                    group.tableCount = row.values[ImportTableCount].empty() ? 1 : atoi(row.values[ImportTableCount].c_str());
+                    row.result = reservation.reserveSlot(date, slot - 1, group.firstTable, group.tableCount);
+                } else if (row.result == BookingOk){
+                    row.result = SlotTaken;
+                    while (findSeating(date, slot, atoi(row.values[ImportParty].c_str()), group)){
+                        if (reservation.reserveSlot(date, slot - 1, group.firstTable, group.tableCount) == BookingOk){
+                            row.result = BookingOk;
+                            break;
+                        }
+                    }
+                }
+                if (row.result != BookingOk){
+                    reject(row.lineNumber, row.result, row.line);
+                    continue;
+                }
+
+                if (Customer::registerID(id)){ // A known ID just gets another booking
+                    LogRecord customerEvent = {};
+                    customerEvent.type = LogCustomer;
+                    customerEvent.customer = Customer(row.values[ImportName], row.values[ImportContact], row.values[ImportEmail], id).toRecord();
+                    batch.push_back(customerEvent);
+                    batchCustomerIDs.push_back(id);
+                    report.newCustomers++;
+                }
+                LogRecord bookingEvent = {};
+                bookingEvent.type = LogBooking;
+                copyField(bookingEvent.customer.customerID, id);
+                bookingEvent.dayNumber = dateToDayNumber(date);
+                bookingEvent.slot = slot - 1;
+                bookingEvent.table = group.firstTable;
+                bookingEvent.quantity = group.tableCount;
+                batch.push_back(bookingEvent);
+                report.imported++;
+
+                if (batch.size() >= commitSize){
+                    isStorageOk = flush();
+                }
+            }
+        }
+
+        isStorageOk = isStorageOk && flush();
+        if (rejects){
+            fclose(rejects);
+        }
+        store.checkpoint();
+        return isStorageOk;
+    }
+
+    // Writes every booking that is not cancelled with its customer, as CSV or as JSON Lines for .json/.jsonl; returns the count or -1
+    long long exportReservations(const string &fileName){
+        METRIC_SCOPE(MetricExport);
+        static const size_t flushSize = 1 << 20;
+        FILE *outFile = fopen(fileName.c_str(), "wb");
+        if (!outFile){
+            return -1;
+        }
+        bool isJson = fileName.size() >= 5 && (fileName.compare(fileName.size() - 5, 5, ".json") == 0 ||
+                                               (fileName.size() >= 6 && fileName.compare(fileName.size() - 6, 6, ".jsonl") == 0));
+
+        string buffer = isJson ? "" : "customerID,name,contact,email,date,slot,table,tableCount,status\n";
+        long long exported = 0;
+        CustomerRecord empty = {};
+        for (size_t i = 0; i < store.bookings.size(); i++){
+            BookingRecord booking = store.bookings.at(i);
+            if (booking.status == BookingCancelled){
+                continue;
+            }
+            string id = fieldToString(booking.customerID);
+            size_t customerRecord = 0;
+            bool isKnown;
+            {
+                lock_guard<mutex> lock(customersMutex);
+                auto found = customerIndex.find(id);
+                isKnown = found != customerIndex.end();
+                customerRecord = isKnown ? found->second : 0;
+            }
+            CustomerRecord customer = isKnown ? store.customerAt(customerRecord) : empty;
+            string name = fieldToString(customer.customerName), contact = fieldToString(customer.contactNumber);
+            string email = fieldToString(customer.customerEmail), date = dayNumberToDate(booking.dayNumber);
+            const char *status = booking.status == BookingPaid ? "paid" : "active";
+
+            if (isJson){
+                buffer += "{\"customerID\":\"" + jsonEscape(id) + "\",\"name\":\"" + jsonEscape(name) + "\",\"contact\":\"" + jsonEscape(contact) +
+                          "\",\"email\":\"" + jsonEscape(email) + "\",\"date\":\"" + date + "\",\"slot\":" + to_string(booking.slot + 1) +
+                          ",\"table\":" + to_string(booking.table) + ",\"tableCount\":" + to_string(booking.tableCount) +
+                          ",\"status\":\"" + status + "\"}\n";
+            } else{
+                buffer += csvField(id) + "," + csvField(name) + "," + csvField(contact) + "," + csvField(email) + "," + date + "," +
+                          to_string(booking.slot + 1) + "," + to_string(booking.table) + "," + to_string(booking.tableCount) + "," + status + "\n";
+            }
+            exported++;
+
+            if (buffer.size() >= flushSize){
+                fwrite(buffer.data(), 1, buffer.size(), outFile);
+                buffer.clear();
+            }
+        }
+        fwrite(buffer.data(), 1, buffer.size(), outFile);
+        return fclose(outFile) == 0 ? exported : -1;
+    }
+};
+
+class ReservationSystem{ // Console client: prompts and screens on top of BookingEngine
+private:
+    static ReservationSystem *instance; // Static instance of the class
+    static once_flag instanceFlag;      // Makes the first getInstance call safe from any thread
+    BookingEngine engine;               // All booking state and rules
+    ReservationSession session;         // The reservation this console is working on
+    Menu menu;
+    TableArea tableArea;                // To handle table information
+
+    ReservationSystem() : tableArea(0, 0, true){ // Private constructor to prevent instantiation
+        if (!engine.open()){
+            cout << "Warning: Unable to open the reservation data files." << endl;
+        }
+    }
+
+    void displayBill(const Bill &bill){
+        cout << endl << setw(25) << left << "Item" << setw(6) << left << "Qty" << setw(12) << right << "Amount" << endl;
+        cout << string(43, '-') << endl;
+        for (const BillLine &line : bill.lines){
+            cout << setw(25) << left << MenuCatalog::instance().nameOf(line.menuID) << setw(6) << left << line.quantity
+                 << setw(12) << right << formatPesos(line.amount) << endl;
+        }
+        cout << string(43, '-') << endl;
+        cout << setw(31) << left << "Subtotal" << setw(12) << right << formatPesos(bill.subtotal) << endl;
+        if (bill.discount > 0){
+            cout << setw(31) << left << "Discount" << setw(12) << right << formatPesos(-bill.discount) << endl;
+        }
+        cout << setw(31) << left << "Service charge (10%)" << setw(12) << right << formatPesos(bill.serviceCharge) << endl;
+        cout << setw(31) << left << "VAT (12%)" << setw(12) << right << formatPesos(bill.tax) << endl;
+        cout << setw(31) << left << "Reservation fee" << setw(12) << right << formatPesos(bill.reservationFee) << endl;
+        cout << setw(31) << left << "Amount due: P" << setw(12) << right << formatPesos(bill.total) << left << endl;
+    }
+
+    void displayFullMenu(){ // Every category of the catalog, one after the other
+        cout << Menu::fullMenu();
+    }
+
+    void showSeating(const string &date, int partySize){ // Slot status with the best-fit tables for the party
+        bool isFullyBooked = true;
+
+        cout << "Availability for " << partySize << " guests on " << date << ":\n";
+        for (int i = 0; i < Reservation::totalSlots; i++){
+            TableGroup group;
+            cout << "Slot " << i + 1 << " (" << 10 + 2 * i << ":00 - " << 12 + 2 * i << ":00): ";
+            if (!engine.findSeating(date, i + 1, partySize, group)){
+                cout << "Reserved\n";
+            } else if (group.tableCount == 1){
+                cout << "Available (Table " << group.firstTable << ")\n";
+                isFullyBooked = false;
+            } else{
+                cout << "Available (Tables " << group.firstTable << "-" << group.firstTable + group.tableCount - 1 << ")\n";
+                isFullyBooked = false;
+            }
+        }
+
+        if (isFullyBooked){
+            string nextDate;
+            int nextSlot;
+            if (engine.findNextSeating(date, 30, partySize, nextDate, nextSlot)){
+                cout << "Fully booked. Next available: Slot " << nextSlot << " on " << nextDate << "\n";
+            }
+        }
+    }
+
+    void showAvailability(const string &date, int table){ // Slot status for one table
+        unsigned long long dayWord = engine.availability(date);
+        unsigned int tableBit = 1u << (table - 1);
+        bool isFullyBooked = true;
+
+        cout << "Availability for Table " << table << " on " << date << ":\n";
+        for (int i = 0; i < Reservation::totalSlots; i++){
+            bool isTaken = Reservation::takenTables(dayWord, i) & tableBit;
+            isFullyBooked = isFullyBooked && isTaken;
+            cout << "Slot " << i + 1 << " (" << 10 + 2 * i << ":00 - " << 12 + 2 * i << ":00): "
+                 << (isTaken ? "Reserved" : "Available") << "\n"; // Show slot status
+        }
+
+        if (isFullyBooked){
+            string nextDate;
+            int nextSlot;
+            if (engine.findNextFreeSlot(date, 30, table, nextDate, nextSlot)){
+                cout << "Fully booked. Next available: Slot " << nextSlot << " on " << nextDate << "\n";
+            }
+        }
+    }
+
+public:
+    // Delete copy constructor and assignment operator to prevent copies
+    ReservationSystem(const ReservationSystem &) = delete;
+    ReservationSystem &operator=(const ReservationSystem &) = delete;
+
+    // Static method to get the instance of ReservationSystem
+    static ReservationSystem *getInstance(){
+        call_once(instanceFlag, [](){ instance = new ReservationSystem(); });
+        return instance;
+    }
+
+    BookingEngine &getEngine(){ return engine; }
+
+    void showHeatmap(int partySize){ // Free slots per day for the next 13 weeks, one row per week from Monday
+        static const int weeks = 13;
+        unsigned char freeSlots[weeks * 7];
+        int today = todayDayNumber();
+        int monday = today - ((today % 7 + 7 + 3) % 7); // Day 0 (1970-01-01) was a Thursday
+        engine.freeSlotsPerDay(dayNumberToDate(monday), weeks * 7, partySize, freeSlots);
+
+        cout << "Free slots per day (" << Reservation::totalSlots << " = wide open, . = fully booked):\n";
+        cout << "Week of      Mon Tue Wed Thu Fri Sat Sun\n";
+        for (int week = 0; week < weeks; week++){
+            cout << dayNumberToDate(monday + week * 7) << "  ";
+            for (int i = week * 7; i < week * 7 + 7; i++){
+                cout << "   " << (monday + i < today ? '-' : freeSlots[i] ? static_cast<char>('0' + freeSlots[i]) : '.');
+            }
+            cout << "\n";
+        }
+        cout << "\n";
+    }
+
+    bool searchReservationByID(const string &id){
+        Customer found;
+        if (engine.findCustomer(id, found)){
+            found.displayCustomerDetails(); // display customer details
+            if (session.customer.getCustomerID() == id && engine.claimPromotion(session)){
+                cout << "Good news: a table freed up. You are booked at Table " << session.reservedTable << ", Slot "
+                     << session.reservationSlot << " on " << session.reservationDate << "." << endl;
+            }
+            return true;
+        }
+        cout << "Reservation ID " << id << " not found." << endl << endl;
+        return false;
+    }
+
+    // Static method to get the single instance
+    void displayAllCustomers(){
+        vector<Customer> customers = engine.registeredCustomers();
+        if (customers.empty()){
+            cout << "No customers have made a reservation yet." << endl;
+        } else{
+            for (size_t i = 0; i < customers.size(); ++i){
+                cout << "Customer " << (i + 1) << " details:" << endl;
+                customers[i].displayCustomerDetails(); // Call Customer's displayCustomerDetails
+            }
+        }
+    }
+
+    void displaySummary(){
+        cout << "\n--- Reservation Summary ---\n";
+        session.customer.displayCustomerDetails();
+
+        if (session.reservationSlot != -1){
+            cout << "Date: " << session.reservationDate << endl;
+            cout << "Time Slot: " << session.reservationSlot << " (" << 10 + 2 * (session.reservationSlot - 1)
+                 << ":00 - " << 12 + 2 * (session.reservationSlot - 1) << ":00)" << endl;
+        }
+
+        if (session.reservedTable != -1 && session.reservedTableCount > 1){
+            cout << "Reserved Tables: " << session.reservedTable << "-" << session.reservedTable + session.reservedTableCount - 1 << endl;
+        } else if (session.reservedTable != -1){
+            cout << "Reserved Table: " << session.reservedTable << endl;
+        }
+
+        if (session.reservationWithMenu && !session.menuOrders.empty()){
+            cout << endl << "Menu Order: " << endl;
+            cout << setw(10) << left << "ID"
+                 << setw(25) << left << "Name"
+                 << setw(10) << left << "Quantity" << endl;
+
+            for (const auto &item : session.menuOrders){
+                cout << setw(10) << left << item.first
+                     << setw(25) << left << MenuCatalog::instance().nameOf(item.first)
+                     << setw(10) << left << item.second << endl;
+            }
+        }
+        cout << string(30, '-') << endl;
+    }
+
+    void makeReservation(){
+        BookingResult registered;
+        do {
+            Customer newCustomer;               // Create a new Customer object
+            newCustomer.inputCustomerDetails(); // Input details for the new customer
+            registered = engine.registerCustomer(session, newCustomer);
+
+            if (registered == BookingOk){
+                cout << endl << "Customer details saved to file successfully." << endl;
+            } else{
+                cout << endl << describeResult(registered) << endl;
+            }
+            waitForKey();
+        } while (registered == DuplicateCustomerID); // Someone else took the ID while it was being typed
+        if (registered != BookingOk){ // Not stored: there is no customer to book for
+            return;
+        }
+
+        clearScreen();
+
+        // Handle reservation choice (Reservation only or Reservation + Food Order)
+        int reservationChoice;
+        bool validChoice = false;
+
+        while (!validChoice){
+            clearScreen();
+            cout << "RESERVATION MENU" << endl;
+            cout << "1. Reservation Only" << endl;
+            cout << "2. Reservation + Food Order" << endl;
+            cout << endl << "Enter choice: ";
+            cin >> reservationChoice;
+
+            if (reservationChoice == 1 || reservationChoice == 2){
+                validChoice = true;
+            } else{
+                cout << "Invalid input. Please enter 1 or 2 only." << endl;
+                waitForKey();
+            }
+        }
+
+        // Reserve date
+        string date;
+        bool isValidDate = false;
+
+        while (!isValidDate){
+            clearScreen();
+            cout << "CHOOSE DATE" << endl << endl;
+            cout << "Enter reservation date (YYYY-MM-DD): ";
+            cin >> date;
+
+            // Validate the date format and check if it's available
+            BookingResult dateResult = engine.checkDate(date);
+            if (dateResult == BookingOk){
+                isValidDate = true; // Exit loop if valid
+
+                clearScreen();
+                cout << "CHOOSE TABLE" << endl << endl;
+                int partySize;
+                int table = tableArea.reserveTable(partySize); // call function to reserve table
+
+                // Reserve slot
+                int slot;
+                bool validSlot = false;
+
+                while (!validSlot){
+                    clearScreen();
+                    cout << "CHOOSE TIME" << endl << endl;
+                    if (table == 0){
+                        showSeating(date, partySize); // Best-fit tables per slot
+                    } else{
+                        showAvailability(date, table); // Check if date is available or not
+                    }
+
+                    cout << endl << "Enter slot number (1-5): ";
+                    cin >> slot;
+
+                    if (slot < 1 || slot > 5){ // validation for time slot
+                        cout << "Invalid input. Please enter a number between 1 to 5 only." << endl << endl;
+                        waitForKey();
+                        continue;
+                    }
+
+                    BookingResult reserved = table == 0 ? engine.seatParty(session, date, slot, partySize)
+                                                        : engine.reserve(session, date, slot, table, partySize);
+                    if (reserved == SlotTaken){ // Offer a place in line for the slot instead
+                        char joinChoice;
+                        cout << "That slot is taken. Join the waitlist for Slot " << slot << " on " << date << "? (Y/N): ";
+                        cin >> joinChoice;
+                        if (toupper(joinChoice) == 'Y'){
+                            reserved = engine.joinWaitlist(session, date, slot, max(partySize, 1));
+                        }
+                    }
+                    if (reserved == Waitlisted){
+                        cout << describeResult(reserved) << endl << endl;
+                        waitForKey();
+                        return;
+                    }
+                    if (reserved != BookingOk){
+                        cout << describeResult(reserved) << endl;
+                        cout << "Unable to reserve slot. Please try again." << endl << endl;
+                        waitForKey();
+                        return;
+                    }
+                    validSlot = true;
+                    cout << endl << "Reservation successful for Table " << session.reservedTable;
+                    if (session.reservedTableCount > 1){
+                        cout << "-" << session.reservedTable + session.reservedTableCount - 1;
+                    }
+                    cout << ", Slot " << slot << " on " << date << "." << endl;
+                    waitForKey();
+                }
+            } else{
+                cout << describeResult(dateResult) << endl << endl;
+                waitForKey();
+            }
+        }
+
+        if (reservationChoice == 2){ // display all menu at once
+            clearScreen();
+            cout << "RESTAURANT MENU" << endl << endl;
+
+            displayFullMenu();
+
+            ReservationSystem::getInstance()->menuOrder(); // allow customer to order from menu
+        }
+    }
+
+    void menuOrder(){ // function to allow customer to order from menu
+        char continueOrdering = 'Y';
+        session.reservationWithMenu = false;
+
+        while (continueOrdering == 'Y'){
+            cout << "What would you like to order?" << endl;
+            cout << "Enter Menu ID: ";
+            int orderItemID;
+            cin >> orderItemID;
+
+            if (cin.fail()){
+                cin.clear();                                         // Clear the error flag
+                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore invalid input
+                cout << "Invalid input. Please enter a valid Menu ID." << endl;
+                continue;
+            }
+
+            int quantity;
+            cout << "Enter quantity: ";
+            cin >> quantity;
+            if (cin.fail()){
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                quantity = 0;
+            }
+
+            if (engine.order(session, orderItemID, quantity) == BookingOk){
+                cout << "Order added successfully!" << endl;
+            } else{
+                cout << "Invalid Menu ID. Try again." << endl;
+            }
+
+            cout << endl << "Would you like to order another item? (Y/N): ";
+            cin >> continueOrdering;
+            continueOrdering = toupper(continueOrdering);
+            cout << endl;
+
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+        cout << "Your Order Summary: " << endl;
+        for (const auto &item : session.menuOrders){
+            cout << "- Item ID: " << item.first << " (" << MenuCatalog::instance().nameOf(item.first) << ") x" << item.second << endl;
+        }
+        cout << endl;
+        waitForKey();
+    }
+
+    void viewMenu() {
+    bool continueViewing = true;
+
+    while (continueViewing) {
+        string category;
+        clearScreen();
+
+        const MenuCatalog &catalog = MenuCatalog::instance();
+
+        cout << "VIEW MENU" << endl;
+        cout << endl << "Select a menu category:" << endl;
+        for (int i = 0; i < catalog.categoryCount(); i++){
+            cout << i + 1 << ". " << catalog.categoryName(i) << endl;
+        }
+        cout << endl << "Enter your choice: ";
+
+        int menuChoice;
+        cin >> menuChoice;
+
+        if (cin.fail() || menuChoice < 1 || menuChoice > catalog.categoryCount()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Invalid choice. Try again." << endl << endl;
+            waitForKey();
+            continue; // Restart the loop for valid input
+        }
+        category = catalog.categoryName(menuChoice - 1);
+
+        Menu categoryMenu(menuChoice - 1);
+        clearScreen();
+        cout << "MENU: " << category << endl;
+        cout << "--------------------------------" << endl;
+        categoryMenu.displayMenu();
+        cout << endl;
+
+        bool validInput = false;
+
+        while (!validInput) {
+            cout << "Would you like to view other menu categories? (Y/N): ";
+            char viewMenuChoice;
+            cin >> viewMenuChoice;
+            viewMenuChoice = toupper(viewMenuChoice);
+
+            if (viewMenuChoice == 'Y') {
+                validInput = true; // Exit validation loop
+            } else if (viewMenuChoice == 'N') {
+                validInput = true;       // Exit validation loop
+                continueViewing = false; // Exit outer loop
+            } else {
+                cout << "Invalid input. Please enter 'Y' or 'N' only." << endl << endl;
+                waitForKey();
+                clearScreen();
+                cout << "MENU: " << category << endl;
+                cout << "--------------------------------" << endl;
+                categoryMenu.displayMenu();
+                cout << endl;
+            }
+        }
+    }
+}
+
+    void updateReservation(){
+        clearScreen();
+        cout << "UPDATE RESERVATION" << endl;
+        cout << "1. Change date and time" << endl;
+        cout << "2. Change table" << endl;
+        cout << "3. Add to order" << endl;
+        cout << "4. Proceed to payment" << endl;
+        cout << "5. Cancel reservation" << endl; // Correct numbering
+        cout << "\nEnter choice: ";
+        int updateChoice;
+        cin >> updateChoice;
+
+        switch (updateChoice){
+        case 1:{
+            clearScreen();
+            cout << "CHANGE DATE AND TIME" << endl << endl;
+            string newDate;
+            cout << "Enter new reservation date (YYYY-MM-DD): ";
+            cin >> newDate;
+
+            BookingResult dateResult = engine.checkDate(newDate);
+            if (dateResult != BookingOk){ // Nothing is touched until the date is valid
+                cout << describeResult(dateResult) << endl;
+                break;
+            }
+
+            int newSlot;
+            cout << "Enter new slot number (1-5): ";
+            if (!(cin >> newSlot) || newSlot < 1 || newSlot > Reservation::totalSlots){
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << describeResult(InvalidSlot) << endl;
+                break;
+            }
+
+            BookingResult modified = engine.modify(session, newDate, newSlot); // Old slot is kept unless the move commits
+            if (modified != BookingOk){
+                cout << describeResult(modified) << endl;
+                cout << "Unable to reserve the new slot.\n";
+            } else{
+                cout << endl << "Reservation successful for Slot " << newSlot << " on " << newDate << "." << endl;
+            }
+            break;
+        }
+
+        case 2:
+            clearScreen();
+            cout << "CHANGE TABLE" << endl << endl;
+        {
+            int partySize;
+            int table = tableArea.reserveTable(partySize);
+            BookingResult changed = engine.changeTable(session, table, partySize);
+            if (changed != BookingOk){
+                cout << describeResult(changed) << endl;
+            } else{
+                cout << "You have successfully reserved Table " << session.reservedTable;
+                if (session.reservedTableCount > 1){
+                    cout << "-" << session.reservedTable + session.reservedTableCount - 1;
+                }
+                cout << endl;
+            }
+            break;
+        }
+
+        case 3:
+            clearScreen();
+            cout << "CHANGE ORDER" << endl << endl;
+            if (session.reservationWithMenu){
+                cout << "RESTAURANT MENU" << endl << endl;
+                displayFullMenu();
+
+                menuOrder();
+            }else{
+                cout << "Menu was not selected initially." << endl;
+            }
+            break;
+
+        case 4:{
+            clearScreen();
+            cout << "PROCEED TO PAYMENT" << endl << endl;
+
+            // Check if the payment has already been made
+            if (session.isPaid){
+                cout << "Payment is already completed. Returning to the main menu.\n";
+                break;
+            }
+            if (session.bookingIndex < 0){
+                cout << describeResult(NoBooking) << endl;
+                break;
+            }
+
+            int paymentChoice;
+            cout << "Select payment method:\n";
+            cout << "1. Credit Card\n";
+            cout << "2. Online Payment\n";
+            cout << endl << "Enter choice: ";
+            cin >> paymentChoice;
+
+            if (paymentChoice != 1 && paymentChoice != 2){
+                cout << describeResult(InvalidPaymentMethod) << endl;
+                break;
+            }
+            displayBill(engine.bill(session));
+
+            string reference;
+            cout << (paymentChoice == 1 ? "Enter credit card number: " : "Enter Online Payment Transaction ID: ");
+            cin.ignore();
+            getline(cin, reference);
+
+            BookingResult paid = engine.pay(session, paymentChoice, reference);
+            if (paid == BookingOk){
+                cout << (paymentChoice == 1 ? "Payment successful using Credit Card!" : "Payment successful using Online Payment!") << endl;
+            } else{
+                cout << describeResult(paid) << endl;
+            }
+            break;
+        }
+
+        case 5:
+            clearScreen();
+            cout << "CANCEL RESERVATION" << endl << endl;
+            if (engine.cancel(session) == BookingOk){
+                cout << "Your reservation has been cancelled." << endl;
+            } else{
+                cout << describeResult(StorageError) << " Your reservation was not cancelled." << endl;
+            }
+            break;
+
+        default:
+            cout << "Invalid choice." << endl;
+            break;
+        }
+    }
+
+    void viewReservationSummary(){
+        session.customer.displayCustomerDetails();
+        displaySummary();
+        updateReservation();
+    }
+};
+
+ReservationSystem *ReservationSystem::instance = nullptr; // Initialize static member
+once_flag ReservationSystem::instanceFlag;
+
+enum ScriptCommand { ScriptCheck, ScriptRegister, ScriptReserve, ScriptSeat, ScriptOrder, ScriptSearch, ScriptMove, ScriptModify,
+                     ScriptWaitlist, ScriptPay, ScriptCancel, ScriptClose, scriptCommandCount };
+
+const char *const scriptCommandNames[scriptCommandCount] = {"check", "register", "reserve", "seat", "order", "search", "move", "modify",
+                                                            "waitlist", "pay", "cancel", "close"};
+
+struct ScriptStep{ // One line of a session script: session|command|arguments...
+    string session;
+    ScriptCommand command;
+    vector<string> args;
+};
+
+// Plays session scripts against a BookingEngine with no terminal I/O. Each line names a session, so one
+// script can interleave many customers. Commands and their arguments:
+//   check|date                  register|id|name|contact|email
+//   reserve|date|slot|table[|party]
+//   seat|date|slot|party        move|date|slot|table[|tableCount|party]  (table 0 = best fit)
+//   order|menuID[|quantity]     modify|date|slot
+//   search|id                   waitlist|date|slot|party
+//   pay|method|reference        cancel
+//   close                       (forgets the session)
+class ScriptRunner{
+private:
+    BookingEngine &engine;
+    unordered_map<string, ReservationSession> sessions;
+
+    static int intArg(const ScriptStep &step, size_t index, int fallback){
+        return index < step.args.size() ? atoi(step.args[index].c_str()) : fallback;
+    }
+
+    static string arg(const ScriptStep &step, size_t index){
+        return index < step.args.size() ? step.args[index] : string();
+    }
+
+public:
+    explicit ScriptRunner(BookingEngine &engine) : engine(engine) {}
+
+    static bool parse(const string &line, ScriptStep &step){ // false for blank lines, # comments and unknown commands
+        if (line.empty() || line[0] == '#'){
+            return false;
+        }
+        vector<string> fields;
+        size_t start = 0;
+        while (true){
+            size_t bar = line.find('|', start);
+            fields.push_back(line.substr(start, bar == string::npos ? string::npos : bar - start));
+            if (bar == string::npos){
+                break;
+            }
+            start = bar + 1;
+        }
+        if (fields.size() < 2){
+            return false;
+        }
+        auto name = find(scriptCommandNames, scriptCommandNames + scriptCommandCount, fields[1]);
+        if (name == scriptCommandNames + scriptCommandCount){
+            return false;
+        }
+        step.session = fields[0];
+        step.command = static_cast<ScriptCommand>(name - scriptCommandNames);
+        step.args.assign(fields.begin() + 2, fields.end());
+        return true;
+    }
+
+    BookingResult run(const ScriptStep &step){
+        ReservationSession &session = sessions[step.session];
+        switch (step.command){
+        case ScriptCheck:
+            return engine.checkDate(arg(step, 0));
+        case ScriptRegister:
+            return engine.registerCustomer(session, Customer(arg(step, 1), arg(step, 2), arg(step, 3), arg(step, 0)));
+        case ScriptReserve:
+            return engine.reserve(session, arg(step, 0), intArg(step, 1, -1), intArg(step, 2, -1), intArg(step, 3, 0));
+        case ScriptSeat:
+            return engine.seatParty(session, arg(step, 0), intArg(step, 1, -1), intArg(step, 2, 0));
+        case ScriptOrder:
+            return engine.order(session, intArg(step, 0, -1), intArg(step, 1, 1));
+        case ScriptSearch:{
+            Customer found;
+            return engine.findCustomer(arg(step, 0), found) ? BookingOk : InvalidCustomerID;
+        }
+        case ScriptMove:
+            return engine.move(session, arg(step, 0), intArg(step, 1, -1), intArg(step, 2, 0), intArg(step, 3, 1), intArg(step, 4, 0));
+        case ScriptModify:
+            return engine.modify(session, arg(step, 0), intArg(step, 1, -1));
+        case ScriptWaitlist:
+            return engine.joinWaitlist(session, arg(step, 0), intArg(step, 1, -1), intArg(step, 2, 0));
+        case ScriptPay:
+            return engine.pay(session, intArg(step, 0, 0), arg(step, 1));
+        case ScriptCancel:
+            return engine.cancel(session);
+        case ScriptClose:
+            sessions.erase(step.session);
+            return BookingOk;
+        default:
+            return BookingOk;
+        }
+    }
+
+    const ReservationSession *sessionOf(const string &name) const{
+        auto it = sessions.find(name);
+        return it == sessions.end() ? nullptr : &it->second;
+    }
+
+    // Runs a script file, writing line|command|OK or line|command|ERROR|reason for every step; -1 if unreadable
+    long long runFile(const string &fileName, ostream &out){
+        LineReader reader(fileName);
+        if (!reader.isOpen()){
+            return -1;
+        }
+        string line;
+        ScriptStep step;
+        long long lineNumber = 0, failed = 0;
+        while (reader.nextLine(line)){
+            lineNumber++;
+            if (!parse(line, step)){
+                if (!line.empty() && line[0] != '#'){
+                    out << lineNumber << "|?|ERROR|Unknown command." << '\n';
+                    failed++;
+                }
+                continue;
+            }
+            BookingResult result = run(step);
+            out << lineNumber << '|' << scriptCommandNames[step.command] << '|';
+            if (result != BookingOk){
+                out << "ERROR|" << describeResult(result) << '\n';
+                failed++;
+                continue;
+            }
+            out << "OK";
+            const ReservationSession *session = sessionOf(step.session);
+            if (session && session->bookingIndex >= 0 && (step.command == ScriptReserve || step.command == ScriptSeat ||
+                step.command == ScriptMove || step.command == ScriptModify || step.command == ScriptWaitlist)){
+                out << '|' << session->reservationDate << '|' << session->reservationSlot << '|' << session->reservedTable << '|'
+                    << session->reservedTableCount;
+            }
+            out << '\n';
+        }
+        return failed;
+    }
+};
+
+#ifdef __linux__
+// Online channel: a single-threaded epoll HTTP/1.1 server with JSON responses over the shared BookingEngine.
+//   GET  /availability?date=YYYY-MM-DD&party=P
+//   POST /reservations  {"customerID","name","contact","email","date","slot","table" or "party"}
+//   POST /orders        {"customerID","menuID","quantity"}
+//   GET  /customers?id=ID
+//   GET  /kitchen?date=YYYY-MM-DD&slot=S[&fire=1]
+
+bool queryParam(const string &target, const string &key, string &value){ // Percent-decoded value of ?key=...
+    size_t start = target.find('?');
+    while (start != string::npos){
+        size_t end = target.find('&', start + 1);
+        string pair = target.substr(start + 1, end == string::npos ? string::npos : end - start - 1);
+        if (pair.compare(0, key.size() + 1, key + "=") == 0){
+            value.clear();
+            for (size_t i = key.size() + 1; i < pair.size(); i++){
+                if (pair[i] == '%' && i + 2 < pair.size()){
+                    value += static_cast<char>(strtol(pair.substr(i + 1, 2).c_str(), nullptr, 16));
+                    i += 2;
+                } else{
+                    value += pair[i] == '+' ? ' ' : pair[i];
+                }
+            }
+            return true;
+        }
+        start = end;
+    }
+    return false;
+}
+
+volatile sig_atomic_t serverStopRequested = 0;
+
+void requestServerStop(int){
+    serverStopRequested = 1;
+}
+
+class BookingServer{
+private:
+    struct Connection{
+        string input;
+        string output;
+        size_t outputSent = 0;
+        bool closeAfterWrite = false;
+    };
+
+    static const size_t maxRequestSize = 64 * 1024;
+
+    BookingEngine &engine;
+    int listenFd = -1;
+    int epollFd = -1;
+    unordered_map<int, Connection> connections;
+    unordered_map<string, ReservationSession> sessions; // Customer ID -> that customer's online session
+
+    static void setNonBlocking(int fd){
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    static void appendResponse(Connection &connection, int status, const string &body, const char *contentType = "application/json"){
+        const char *reason = status == 200 ? "OK" : status == 201 ? "Created" : status == 202 ? "Accepted" : status == 404 ? "Not Found"
+                           : status == 409 ? "Conflict" : status == 413 ? "Payload Too Large" : "Bad Request";
+        connection.output += "HTTP/1.1 " + to_string(status) + " " + reason + "\r\n";
+        connection.output += string("Content-Type: ") + contentType + "\r\nContent-Length: " + to_string(body.size()) + "\r\n";
+        if (connection.closeAfterWrite){
+            connection.output += "Connection: close\r\n";
+        }
+        connection.output += "\r\n";
+        connection.output += body;
+    }
+
+    static string errorBody(BookingResult result){
+        return string("{\"error\":\"") + jsonEscape(describeResult(result)) + "\"}";
+    }
+
+    static int statusFor(BookingResult result){
+        return result == SlotTaken || result == AlreadyBooked || result == AlreadyWaitlisted || result == DuplicateCustomerID ? 409 : 400;
+    }
+
+    ReservationSession *sessionFor(const string &customerID){ // Existing session, or one opened for a stored customer
+        auto it = sessions.find(customerID);
+        if (it != sessions.end()){
+            return &it->second;
+        }
+        Customer stored;
+        if (!engine.findCustomer(customerID, stored)){
+            return nullptr;
+        }
+        ReservationSession &session = sessions[customerID];
+        session.customer = stored;
+        return &session;
+    }
+
+    ReservationSession *claimedSessionFor(const string &customerID){ // Same, with any booking made off the waitlist picked up
+        ReservationSession *session = sessionFor(customerID);
+        if (session){
+            engine.claimPromotion(*session);
+        }
+        return session;
+    }
+
+    void handleAvailability(Connection &connection, const string &target){ // Optional &party=P adds the best table per slot
+        string date, party;
+        if (!queryParam(target, "date", date) || !isValidDate(date)){
+            appendResponse(connection, 400, errorBody(InvalidDateFormat));
+            return;
+        }
+
+        unsigned long long dayWord = engine.availability(date);
+        string body = "{\"date\":\"" + date + "\",\"reserved\":[";
+        for (int slot = 1; slot <= Reservation::totalSlots; slot++){
+            body += engine.isSlotFull(dayWord, slot) ? "true" : "false";
+            body += slot < Reservation::totalSlots ? "," : "]";
+        }
+
+        if (queryParam(target, "party", party)){ // Best-fit first table and table count per slot
+            string tableList = ",\"table\":[", countList = ",\"tableCount\":[";
+            for (int slot = 1; slot <= Reservation::totalSlots; slot++){
+                TableGroup group;
+                bool isSeated = engine.findSeating(date, slot, atoi(party.c_str()), group);
+                tableList += isSeated ? to_string(group.firstTable) : "null";
+                countList += isSeated ? to_string(group.tableCount) : "0";
+                tableList += slot < Reservation::totalSlots ? "," : "]";
+                countList += slot < Reservation::totalSlots ? "," : "]";
+            }
+            body += tableList + countList;
+        }
+        appendResponse(connection, 200, body + "}");
+    }
+
+    void handleHeatmap(Connection &connection, const string &target){ // ?from=&days=&party=, days up to 366
+        string from, days, party;
+        if (!queryParam(target, "from", from) || !isValidDate(from)){
+            appendResponse(connection, 400, errorBody(InvalidDateFormat));
+            return;
+        }
+        int dayCount = queryParam(target, "days", days) ? min(max(atoi(days.c_str()), 1), 366) : 90;
+        int partySize = queryParam(target, "party", party) ? max(atoi(party.c_str()), 0) : 0;
+
+        unsigned char freeSlots[366];
+        engine.freeSlotsPerDay(from, dayCount, partySize, freeSlots);
+        string body = "{\"from\":\"" + from + "\",\"party\":" + to_string(partySize) + ",\"free\":[";
+        for (int i = 0; i < dayCount; i++){
+            body += to_string(freeSlots[i]);
+            body += i + 1 < dayCount ? "," : "]";
+        }
+        appendResponse(connection, 200, body + "}");
+    }
+
+    void handleOpenings(Connection &connection, const string &target){ // ?from=&party=&count=&days=: first open dates and their slots
+        string from, party, count, days;
+        if (!queryParam(target, "from", from) || !isValidDate(from)){
+            appendResponse(connection, 400, errorBody(InvalidDateFormat));
+            return;
+        }
+        int partySize = queryParam(target, "party", party) ? max(atoi(party.c_str()), 0) : 0;
+        int maxDates = queryParam(target, "count", count) ? min(max(atoi(count.c_str()), 1), 31) : 5;
+        int dayCount = queryParam(target, "days", days) ? min(max(atoi(days.c_str()), 1), 3660) : 366;
+
+        int dayNumbers[31];
+        unsigned int slotMasks[31];
+        int found = engine.firstOpenDates(from, dayCount, partySize, maxDates, dayNumbers, slotMasks);
+        string body = "{\"dates\":[";
+        for (int i = 0; i < found; i++){
+            body += (i ? ",{\"date\":\"" : "{\"date\":\"") + dayNumberToDate(dayNumbers[i]) + "\",\"slots\":[";
+            bool isFirst = true;
+            for (int slot = 0; slot < Reservation::totalSlots; slot++){
+                if (slotMasks[i] & (1u << slot)){
+                    body += (isFirst ? "" : ",") + to_string(slot + 1);
+                    isFirst = false;
+                }
+            }
+            body += "]}";
+        }
+        appendResponse(connection, 200, body + "]}");
+    }
+
+    void handleReservation(Connection &connection, const string &body){
+        string id, name, contact, email, date;
+        jsonField(body, "customerID", id);
+        jsonField(body, "date", date);
+
+        ReservationSession *session = claimedSessionFor(id);
+        if (!session){ // New customer: register first
+            jsonField(body, "name", name);
+            jsonField(body, "contact", contact);
+            jsonField(body, "email", email);
+            ReservationSession newSession;
+            BookingResult registered = engine.registerCustomer(newSession, Customer(name, contact, email, id));
+            if (registered != BookingOk){
+                appendResponse(connection, statusFor(registered), errorBody(registered));
+                return;
+            }
+            session = &(sessions[id] = newSession);
+        }
+
+        int slot = jsonInt(body, "slot", -1);
+        int partySize = jsonInt(body, "party", 0);
+        int table = jsonInt(body, "table", -1);
+
+        BookingResult reserved = table < 0 && partySize > 0 ? engine.seatParty(*session, date, slot, partySize) // No table: best fit
+                                                            : engine.reserve(*session, date, slot, table, partySize);
+        if (reserved != BookingOk){
+            appendResponse(connection, statusFor(reserved), errorBody(reserved));
+            return;
+        }
+        appendResponse(connection, 201, "{\"customerID\":\"" + jsonEscape(id) + "\",\"date\":\"" + date +
+                       "\",\"slot\":" + to_string(session->reservationSlot) + ",\"table\":" + to_string(session->reservedTable) +
+                       ",\"tableCount\":" + to_string(session->reservedTableCount) + "}");
+    }
+
+    void handleOrder(Connection &connection, const string &body){
+        string id;
+        jsonField(body, "customerID", id);
+        ReservationSession *session = claimedSessionFor(id);
+        if (!session){
+            appendResponse(connection, 404, "{\"error\":\"Unknown customer.\"}");
+            return;
+        }
+
+        BookingResult ordered = engine.order(*session, jsonInt(body, "menuID", -1), jsonInt(body, "quantity", 1));
+        if (ordered != BookingOk){
+            appendResponse(connection, statusFor(ordered), errorBody(ordered));
+            return;
+        }
+        appendResponse(connection, 201, "{\"customerID\":\"" + jsonEscape(id) + "\",\"items\":" + to_string(session->orders.size()) + "}");
+    }
+
+    void handleWaitlist(Connection &connection, const string &body){ // {"customerID","date","slot","party"}; 202 while waiting
+        string id, date;
+        jsonField(body, "customerID", id);
+        jsonField(body, "date", date);
+        ReservationSession *session = claimedSessionFor(id);
+        if (!session){
+            appendResponse(connection, 404, "{\"error\":\"Unknown customer.\"}");
+            return;
+        }
+
+        int slot = jsonInt(body, "slot", -1);
+        BookingResult joined = engine.joinWaitlist(*session, date, slot, jsonInt(body, "party", 0));
+        if (joined == Waitlisted){
+            appendResponse(connection, 202, "{\"customerID\":\"" + jsonEscape(id) + "\",\"date\":\"" + date + "\",\"slot\":" +
+                           to_string(slot) + ",\"waiting\":true}");
+        } else if (joined != BookingOk){
+            appendResponse(connection, statusFor(joined), errorBody(joined));
+        } else{
+            appendResponse(connection, 201, "{\"customerID\":\"" + jsonEscape(id) + "\",\"date\":\"" + date + "\",\"slot\":" +
+                           to_string(session->reservationSlot) + ",\"table\":" + to_string(session->reservedTable) +
+                           ",\"tableCount\":" + to_string(session->reservedTableCount) + "}");
+        }
+    }
+
+    void handleMove(Connection &connection, const string &body){ // {"customerID","date","slot"} plus "table"/"tableCount" or "party"
+        string id, date;
+        jsonField(body, "customerID", id);
+        jsonField(body, "date", date);
+        ReservationSession *session = claimedSessionFor(id);
+        if (!session){
+            appendResponse(connection, 404, "{\"error\":\"Unknown customer.\"}");
+            return;
+        }
+
+        BookingResult moved = engine.move(*session, date, jsonInt(body, "slot", -1), jsonInt(body, "table", 0),
+                                          jsonInt(body, "tableCount", 1), jsonInt(body, "party", 0));
+        if (moved != BookingOk){
+            appendResponse(connection, statusFor(moved), errorBody(moved));
+            return;
+        }
+        appendResponse(connection, 200, "{\"customerID\":\"" + jsonEscape(id) + "\",\"date\":\"" + session->reservationDate +
+                       "\",\"slot\":" + to_string(session->reservationSlot) + ",\"table\":" + to_string(session->reservedTable) +
+                       ",\"tableCount\":" + to_string(session->reservedTableCount) + "}");
+    }
+
+    void handleCancel(Connection &connection, const string &body){ // {"customerID"}: frees the tables for the waitlist
+        string id;
+        jsonField(body, "customerID", id);
+        ReservationSession *session = claimedSessionFor(id);
+        if (!session){
+            appendResponse(connection, 404, "{\"error\":\"Unknown customer.\"}");
+            return;
+        }
+        BookingResult cancelled = engine.cancel(*session);
+        if (cancelled != BookingOk){
+            appendResponse(connection, statusFor(cancelled), errorBody(cancelled));
+            return;
+        }
+        appendResponse(connection, 200, "{\"customerID\":\"" + jsonEscape(id) + "\",\"cancelled\":true}");
+    }
+
+    void handleLookup(Connection &connection, const string &target){
+        string id;
+        Customer found;
+        if (!queryParam(target, "id", id) || !engine.findCustomer(id, found)){
+            appendResponse(connection, 404, "{\"error\":\"Reservation ID not found.\"}");
+            return;
+        }
+        appendResponse(connection, 200, "{\"customerID\":\"" + jsonEscape(found.getCustomerID()) + "\",\"name\":\"" + jsonEscape(found.getCustomerName()) +
+                       "\",\"contact\":\"" + jsonEscape(found.getContactNumber()) + "\",\"email\":\"" + jsonEscape(found.getCustomerEmail()) + "\"}");
+    }
+
+    void handleKitchen(Connection &connection, const string &target){
+        string date, slot, fire;
+        if (!queryParam(target, "date", date) || !isValidDate(date) || !queryParam(target, "slot", slot)){
+            appendResponse(connection, 400, errorBody(InvalidDateFormat));
+            return;
+        }
+
+        const MenuCatalog &catalog = MenuCatalog::instance();
+        vector<KitchenBatch> batches = engine.kitchenBatches(date, atoi(slot.c_str()), queryParam(target, "fire", fire) && fire == "1");
+        string body = "{\"date\":\"" + date + "\",\"slot\":" + to_string(atoi(slot.c_str())) + ",\"batches\":[";
+        for (size_t i = 0; i < batches.size(); i++){
+            body += (i ? ",{\"station\":\"" : "{\"station\":\"") + jsonEscape(batches[i].station >= 0 ? catalog.categoryName(batches[i].station) : "") +
+                    "\",\"menuID\":" + to_string(batches[i].menuID) + ",\"name\":\"" + jsonEscape(catalog.nameOf(batches[i].menuID)) +
+                    "\",\"quantity\":" + to_string(batches[i].quantity) + "}";
+        }
+        appendResponse(connection, 200, body + "]}");
+    }
+
+    void route(Connection &connection, const string &method, const string &target, const string &body){
+        string path = target.substr(0, target.find('?'));
+        if (method == "GET" && path == "/availability"){
+            handleAvailability(connection, target);
+        } else if (method == "GET" && path == "/heatmap"){
+            handleHeatmap(connection, target);
+        } else if (method == "GET" && path == "/openings"){
+            handleOpenings(connection, target);
+        } else if (method == "POST" && path == "/reservations"){
+            handleReservation(connection, body);
+        } else if (method == "POST" && path == "/orders"){
+            handleOrder(connection, body);
+        } else if (method == "POST" && path == "/waitlist"){
+            handleWaitlist(connection, body);
+        } else if (method == "POST" && path == "/move"){
+            handleMove(connection, body);
+        } else if (method == "POST" && path == "/cancel"){
+            handleCancel(connection, body);
+        } else if (method == "GET" && path == "/customers"){
+            handleLookup(connection, target);
+        } else if (method == "GET" && path == "/kitchen"){
+            handleKitchen(connection, target);
+#ifndef NO_METRICS
+        } else if (method == "GET" && path == "/metrics"){
+            appendResponse(connection, 200, Metrics::instance().prometheusText(), "text/plain; version=0.0.4");
+#endif
+        } else{
+            appendResponse(connection, 404, "{\"error\":\"Not found.\"}");
+        }
+    }
+
+    void processInput(Connection &connection){ // Handles every complete request in the buffer (pipelining included)
+        size_t consumed = 0;
+        while (!connection.closeAfterWrite){
+            size_t headerEnd = connection.input.find("\r\n\r\n", consumed);
+            if (headerEnd == string::npos){
+                break;
+            }
+
+            string head = connection.input.substr(consumed, headerEnd - consumed);
+            size_t lineEnd = head.find("\r\n");
+            string requestLine = head.substr(0, lineEnd);
+            size_t firstSpace = requestLine.find(' ');
+            size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+            if (firstSpace == string::npos || secondSpace == string::npos){
+                connection.closeAfterWrite = true;
+                appendResponse(connection, 400, "{\"error\":\"Bad request.\"}");
+                break;
+            }
+
+            size_t contentLength = 0;
+            bool keepAlive = requestLine.compare(secondSpace + 1, string::npos, "HTTP/1.1") == 0;
+            for (size_t pos = lineEnd; pos != string::npos && pos < head.size();){
+                size_t next = head.find("\r\n", pos + 2);
+                string header = head.substr(pos + 2, next == string::npos ? string::npos : next - pos - 2);
+                for (size_t i = 0; i < header.size() && header[i] != ':'; i++){
+                    header[i] = tolower(header[i]);
+                }
+                if (header.compare(0, 15, "content-length:") == 0){
+                    contentLength = strtoul(header.c_str() + 15, nullptr, 10);
+                } else if (header.compare(0, 11, "connection:") == 0){
+                    keepAlive = header.find("close") == string::npos && (keepAlive || header.find("keep-alive") != string::npos);
+                }
+                pos = next;
+            }
+
+            if (headerEnd + 4 - consumed + contentLength > maxRequestSize){
+                connection.closeAfterWrite = true;
+                appendResponse(connection, 413, "{\"error\":\"Request too large.\"}");
+                break;
+            }
+            if (connection.input.size() < headerEnd + 4 + contentLength){
+                break; // Body still arriving
+            }
+
+            connection.closeAfterWrite = !keepAlive;
+            route(connection, requestLine.substr(0, firstSpace), requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1),
+                  connection.input.substr(headerEnd + 4, contentLength));
+            consumed = headerEnd + 4 + contentLength;
+        }
+        connection.input.erase(0, consumed);
+
+        if (connection.input.size() > maxRequestSize && !connection.closeAfterWrite){
+            connection.closeAfterWrite = true;
+            appendResponse(connection, 413, "{\"error\":\"Request too large.\"}");
+        }
+    }
+
+    void closeConnection(int fd){
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    bool flushOutput(int fd, Connection &connection){ // False once the connection is closed
+        while (connection.outputSent < connection.output.size()){
+            ssize_t written = send(fd, connection.output.data() + connection.outputSent, connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+            if (written < 0){
+                if (errno == EAGAIN || errno == EWOULDBLOCK){
+                    epoll_event event = {};
+                    event.events = connection.closeAfterWrite ? EPOLLOUT : EPOLLIN | EPOLLOUT; // Input left unread must not wake us
+                    event.data.fd = fd;
+                    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+                    return true;
+                }
+                closeConnection(fd);
+                return false;
+            }
+            connection.outputSent += written;
+        }
+
+        connection.output.clear();
+        connection.outputSent = 0;
+        if (connection.closeAfterWrite){
+            closeConnection(fd);
+            return false;
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        return true;
+    }
+
+    void acceptConnections(){
+        while (true){
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0){
+                return; // EAGAIN: backlog drained
+            }
+            setNonBlocking(fd);
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            connections[fd];
+        }
+    }
+
+    bool readInput(int fd, Connection &connection){ // False if the peer closed or failed
+        char buffer[16 * 1024];
+        while (connection.input.size() <= maxRequestSize){ // Past the cap processInput answers 413 and the rest stays unread
+            if (connection.closeAfterWrite){
+                return true; // Reply pending, then the connection closes; nothing more is worth buffering
+            }
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received > 0){
+                connection.input.append(buffer, received);
+            } else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+                return true;
+            } else{
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit BookingServer(BookingEngine &engine) : engine(engine) {}
+
+    ~BookingServer(){
+        for (auto &entry : connections){
+            close(entry.first);
+        }
+        if (epollFd >= 0){
+            close(epollFd);
+        }
+        if (listenFd >= 0){
+            close(listenFd);
+        }
+    }
+
+    // Loopback only unless isPublic: /cancel and /move act on any customer ID they are given, with no login
+    bool listenOn(int port, bool isPublic = false){
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(isPublic ? INADDR_ANY : INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<unsigned short>(port));
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listenFd, SOMAXCONN) != 0){
+            return false;
+        }
+        setNonBlocking(listenFd);
+
+        epollFd = epoll_create1(0);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        return epollFd >= 0 && epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+    }
+
+    void run(){ // Until SIGINT/SIGTERM
+        signal(SIGINT, requestServerStop);
+        signal(SIGTERM, requestServerStop);
+
+        const int maxEvents = 256;
+        epoll_event events[maxEvents];
+        vector<int> ready;
+
+        while (!serverStopRequested){
+            int count = epoll_wait(epollFd, events, maxEvents, 500);
+            ready.clear();
+            for (int i = 0; i < count; i++){
+                int fd = events[i].data.fd;
+                if (fd == listenFd){
+                    acceptConnections();
+                    continue;
+                }
+
+                auto it = connections.find(fd);
+                if (it == connections.end()){
+                    continue;
+                }
+                if ((events[i].events & (EPOLLERR | EPOLLHUP)) || ((events[i].events & EPOLLIN) && !readInput(fd, it->second))){
+                    closeConnection(fd);
+                    continue;
+                }
+                processInput(it->second);
+                ready.push_back(fd);
+            }
+
+            engine.commitPending(); // One group commit for every request handled in this pass, before any reply leaves
+
+            for (int fd : ready){
+                auto it = connections.find(fd);
+                if (it != connections.end()){
+                    flushOutput(fd, it->second);
+                }
+            }
+        }
+        engine.shutdown();
+    }
+};
+
+// Kitchen queue benchmark: producer threads push bursts of tickets while one consumer folds them into batches
+void runKitchenBenchmark(int producerCount, int ticketsPerProducer){
+    static const int burstSize = 256;
+    KitchenQueue kitchen;
+    MenuCatalog::instance(); // Load the catalog before timing anything
+    atomic<int> finishedProducers(0);
+    vector<vector<long long>> pushNanos(producerCount);
+    vector<long long> drainNanos;
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> producers;
+    for (int producer = 0; producer < producerCount; producer++){
+        producers.emplace_back([&, producer](){
+            pushNanos[producer].reserve(ticketsPerProducer);
+            for (int sent = 0; sent < ticketsPerProducer;){
+                for (int i = 0; i < burstSize && sent < ticketsPerProducer; i++, sent++){
+                    auto pushStart = chrono::steady_clock::now();
+                    kitchen.push(KitchenTicket{20000 + sent % 7, 1 + sent % Reservation::totalSlots, sent % 20, 1});
+                    pushNanos[producer].push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - pushStart).count());
+                }
+                this_thread::sleep_for(chrono::microseconds(50)); // Quiet gap between bursts
+            }
+            finishedProducers++;
+        });
+    }
+
+    long long portions = 0;
+    bool isDone = false;
+    while (!isDone){
+        isDone = finishedProducers.load() == producerCount; // One more full pass after the last producer ends
+        for (int day = 20000; day < 20007; day++){
+            for (int slot = 1; slot <= Reservation::totalSlots; slot++){
+                auto drainStart = chrono::steady_clock::now();
+                vector<KitchenBatch> batches = kitchen.fire(day, slot);
+                drainNanos.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - drainStart).count());
+                for (const KitchenBatch &batch : batches){
+                    portions += batch.quantity;
+                }
+            }
+        }
+    }
+    for (thread &producer : producers){
+        producer.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<long long> allPushes;
+    for (const vector<long long> &nanos : pushNanos){
+        allPushes.insert(allPushes.end(), nanos.begin(), nanos.end());
+    }
+    sort(allPushes.begin(), allPushes.end());
+    sort(drainNanos.begin(), drainNanos.end());
+    cout << "Tickets: " << allPushes.size() << " from " << producerCount << " producers, " << portions << " portions batched" << endl;
+    cout << "Throughput: " << static_cast<long long>(allPushes.size() / seconds) << " tickets/s" << endl;
+    cout << "Enqueue latency: p50 " << allPushes[allPushes.size() / 2] << " ns, p99 " << allPushes[allPushes.size() * 99 / 100] << " ns" << endl;
+    cout << "Dequeue (fire one slot): p50 " << drainNanos[drainNanos.size() / 2] << " ns, p99 " << drainNanos[drainNanos.size() * 99 / 100] << " ns" << endl;
+}
+
+// Load generator for the server: keep-alive connections on localhost issuing availability queries
+void runLoadGenerator(int port, int connectionCount, int seconds){
+    atomic<long long> totalRequests(0);
+    atomic<long long> totalMicros(0);
+    atomic<bool> stop(false);
+    int firstDay = dateToDayNumber("2027-01-01");
+
+    vector<thread> workers;
+    for (int worker = 0; worker < connectionCount; worker++){
+        workers.emplace_back([&, worker](){
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(static_cast<unsigned short>(port));
+            if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0){
+                if (fd >= 0){
+                    close(fd);
+                }
+                return;
+            }
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            string response;
+            char buffer[4096];
+            long long requests = 0, micros = 0;
+            for (int i = worker; !stop; i++){
+                string request = "GET /availability?date=" + dayNumberToDate(firstDay + i % 365) + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+                auto started = chrono::steady_clock::now();
+                if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())){
+                    break;
+                }
+
+                response.clear();
+                size_t expected = string::npos;
+                while (expected == string::npos || response.size() < expected){
+                    ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                    if (received <= 0){
+                        stop = true;
+                        break;
+                    }
+                    response.append(buffer, received);
+                    size_t headerEnd = response.find("\r\n\r\n");
+                    size_t lengthPos = response.find("Content-Length: ");
+                    if (expected == string::npos && headerEnd != string::npos && lengthPos != string::npos){
+                        expected = headerEnd + 4 + strtoul(response.c_str() + lengthPos + 16, nullptr, 10);
+                    }
+                }
+                micros += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - started).count();
+                requests++;
+            }
+            close(fd);
+            totalRequests += requests;
+            totalMicros += micros;
+        });
+    }
+
+    this_thread::sleep_for(chrono::seconds(seconds));
+    stop = true;
+    for (thread &worker : workers){
+        worker.join();
+    }
+
+    long long requests = totalRequests;
+    cout << "Requests: " << requests << " over " << seconds << " s on " << connectionCount << " connections" << endl;
+    cout << "Throughput: " << requests / max(seconds, 1) << " requests/s" << endl;
+    cout << "Mean latency: " << (requests ? totalMicros / requests : 0) << " us" << endl;
+}
+#endif
+
+// Validation scaling: the parallel stage of a bulk import alone, on 1 to 32 threads. Every run must produce
+// the same result for every row, whatever the thread count.
+void runValidationBenchmark(const string &fileName){
+    bool isJson = fileName.size() >= 5 && (fileName.compare(fileName.size() - 5, 5, ".json") == 0 ||
+                                           (fileName.size() >= 6 && fileName.compare(fileName.size() - 6, 6, ".jsonl") == 0));
+    vector<string> lines;
+    LineReader reader(fileName);
+    string line;
+    while (reader.nextLine(line)){
+        lines.push_back(line);
+    }
+    if (lines.empty()){
+        cout << "Error: Nothing to read in " << fileName << "." << endl;
+        return;
+    }
+
+    double baseRate = 0;
+    unsigned int baseDigest = 0;
+    for (int threadCount = 1; threadCount <= 32; threadCount *= 2){
+        WorkStealingPool pool(threadCount);
+        BulkValidator validator(pool, isJson, dateToDayNumber("2000-01-01"));
+        size_t first = isJson ? 0 : 1;
+        if (!isJson && !validator.readHeader(lines[0])){
+            cout << "Error: No customerID column in " << fileName << "." << endl;
+            return;
+        }
+
+        vector<ImportRow> rows(lines.size() - first);
+        for (size_t i = 0; i < rows.size(); i++){
+            rows[i].lineNumber = static_cast<long long>(i + first + 1);
+            rows[i].line = lines[i + first];
+        }
+
+        auto start = chrono::steady_clock::now();
+        validator.validate(rows, rows.size());
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        unsigned int digest = 2166136261u; // FNV-1a over every row's result
+        long long valid = 0;
+        for (const ImportRow &row : rows){
+            digest = (digest ^ static_cast<unsigned int>(row.result)) * 16777619u;
+            valid += row.result == BookingOk ? 1 : 0;
+        }
+        double rate = rows.size() / seconds;
+        if (threadCount == 1){
+            baseRate = rate;
+            baseDigest = digest;
+        }
+        cout << setw(3) << right << threadCount << " threads: " << setw(10) << static_cast<long long>(rate) << " rows/s, speedup "
+             << fixed << setprecision(2) << rate / baseRate << "x, " << valid << " valid" << (digest == baseDigest ? "" : "  RESULTS DIFFER")
+             << left << endl;
+    }
+}
+
+// Fuzz input for the validator checks: digits, separators and the bytes just outside each validator's ranges
+const char fuzzAlphabet[] = "0123456789-- aAzZmM@.._+[`{\x7f\x80\xff/:";
+
+char fuzzByte(mt19937 &random){ return fuzzAlphabet[random() % (sizeof(fuzzAlphabet) - 1)]; }
+
+string mutateSeed(string text, mt19937 &random){ // Flips, inserts or deletes up to three bytes of a seed
+    int edits = random() % 4;
+    for (int i = 0; i < edits; i++){
+        size_t pos = text.empty() ? 0 : random() % (text.size() + 1);
+        char c = fuzzByte(random);
+        int action = random() % 3;
+        if (action == 0 && pos < text.size()){
+            text[pos] = c;
+        } else if (action == 1 || text.empty()){
+            text.insert(text.begin() + min(pos, text.size()), c);
+        } else if (pos < text.size()){
+            text.erase(pos, 1);
+        }
+    }
+    return text;
+}
+
+// Validator check: the std::regex validators the hand-written checks replaced, run side by side over mutated
+// inputs. Dates must also name a real day since the calendar check, so the date regex is paired with that rule;
+// isValidEmail had no regex before, so it is held to the pattern its comments describe. Then ns per call for each.
+bool runValidatorBenchmark(long long iterations){
+    static const char *seeds[] = {"2027-01-05", "2028-02-29", "2027-02-31", "2027-13-05", "09171234567", "0917123456",
+                                  "Juan Dela Cruz", "Ana2", "", " ", "juan.dc@example.com", "a@b.c", "a@@b.c", "x@host", "x@.com"};
+    struct Check{
+        const char *name;
+        const char *source;
+        bool (*scanner)(const string &);
+        bool needsCalendarDay;
+        regex pattern;
+    };
+    Check checks[] = {
+        {"date", "^\\d{4}-(0[1-9]|1[0-2])-(0[1-9]|[12][0-9]|3[01])$", isValidDate, true, regex()},
+        {"contact", "^\\d{11}$", isValidContactInput, false, regex()},
+        {"name", "^[a-zA-Z ]+$", isValidCustomerName, false, regex()},
+        {"email", "^[A-Za-z0-9._+-]+@([A-Za-z0-9-]+\\.)+[A-Za-z0-9-]+$", isValidEmail, false, regex()},
+    };
+    for (Check &check : checks){
+        check.pattern = regex(check.source);
+    }
+
+    mt19937 random(11);
+
+    vector<string> inputs;
+    for (long long i = 0; i < iterations; i++){
+        inputs.push_back(mutateSeed(seeds[random() % (sizeof(seeds) / sizeof(seeds[0]))], random));
+    }
+
+    long long mismatches = 0;
+    for (const Check &check : checks){
+        long long accepted = 0;
+        for (const string &text : inputs){
+            bool expected = regex_match(text, check.pattern) && (!check.needsCalendarDay || isCalendarDay(text));
+            bool actual = check.scanner(text);
+            accepted += actual;
+            if (actual != expected && mismatches++ < 5){
+                cout << check.name << " disagrees on \"" << text << "\": regex " << expected << ", scanner " << actual << endl;
+            }
+        }
+        cout << setw(8) << left << check.name << accepted << " of " << inputs.size() << " accepted" << endl;
+    }
+    cout << "Checked " << inputs.size() << " inputs against 4 validators: " << mismatches << " mismatches" << endl;
+
+    size_t timedInputs = min(inputs.size(), static_cast<size_t>(20000));
+    size_t regexInputs = min(timedInputs, static_cast<size_t>(2000)); // Compiling a regex per call costs tens of microseconds
+    for (const Check &check : checks){
+        volatile int sink = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < regexInputs; i++){
+            sink = sink + regex_match(inputs[i], regex(check.source)); // The old validators built the regex on every call
+        }
+        double regexNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / regexInputs;
+
+        const int rounds = 50;
+        start = chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++){
+            for (size_t i = 0; i < timedInputs; i++){
+                sink = sink + check.scanner(inputs[i]);
+            }
+        }
+        double scannerNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (rounds * timedInputs);
+        cout << setw(8) << left << check.name << fixed << setprecision(1) << "regex " << regexNanos << " ns, scanner " << scannerNanos
+             << " ns per call" << endl;
+    }
+    return mismatches == 0;
+}
+
+// Date module check: every YYYY-MM-DD string with month 00-13 and day 00-32 over years 0000-9999 against an
+// independent calendar rule, day numbers consecutive across the whole range, then parse throughput
+bool runDateBenchmark(){
+    static const int referenceLengths[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    long long checked = 0, wrong = 0;
+    int expectedDay = daysFromCivil(0, 1, 1);
+    string date = "0000-00-00";
+    for (int year = 0; year <= 9999; year++){
+        bool isLeap = year % 400 == 0 || (year % 100 != 0 && year % 4 == 0);
+        for (int month = 0; month <= 13; month++){
+            for (int day = 0; day <= 32; day++){
+                date[0] = '0' + year / 1000;
+                date[1] = '0' + year / 100 % 10;
+                date[2] = '0' + year / 10 % 10;
+                date[3] = '0' + year % 10;
+                date[5] = '0' + month / 10;
+                date[6] = '0' + month % 10;
+                date[8] = '0' + day / 10;
+                date[9] = '0' + day % 10;
+                bool isReal = month >= 1 && month <= 12 && day >= 1 && day <= referenceLengths[month] + (month == 2 && isLeap);
+
+                int dayNumber = 0;
+                bool isParsed = parseDate(date, dayNumber);
+                checked++;
+                if (isParsed != isReal || (isReal && (dayNumber != expectedDay++ || dayNumberToDate(dayNumber) != date))){
+                    if (wrong++ < 5){
+                        cout << "Wrong result for " << date << endl;
+                    }
+                    expectedDay = isReal ? dayNumber + 1 : expectedDay;
+                }
+            }
+        }
+    }
+    cout << "Calendar check: " << checked << " strings, " << wrong << " wrong (2026-02-31 is "
+         << (isValidDate("2026-02-31") ? "accepted" : "rejected") << ", 2028-02-29 is " << (isValidDate("2028-02-29") ? "accepted" : "rejected") << ")" << endl;
+
+    vector<string> dates;
+    for (int i = 0; i < 1000; i++){
+        dates.push_back(dayNumberToDate(todayDayNumber() + i * 37 % 3000 - 500));
+    }
+    auto legacyFormatCheck = [](const string &text){ // What isValidDateFormat did per call before
+        time_t now = time(0);
+        char currentDate[11];
+        tm local = *localtime(&now);
+        strftime(currentDate, sizeof(currentDate), "%Y-%m-%d", &local);
+        return text >= currentDate;
+    };
+
+    const int rounds = 2000;
+    volatile int sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++){
+        for (const string &text : dates){
+            sink = sink + isValidDateFormat(text);
+        }
+    }
+    double cachedNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (rounds * dates.size());
+
+    start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds / 100; round++){
+        for (const string &text : dates){
+            sink = sink + legacyFormatCheck(text);
+        }
+    }
+    double legacyNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (rounds / 100 * dates.size());
+    cout << "isValidDateFormat: " << fixed << setprecision(1) << cachedNanos << " ns per call (localtime/strftime per call: "
+         << legacyNanos << " ns)" << endl;
+    return wrong == 0;
+}
+
+// Fuzzes every vector field kernel against the scalar validators, then times each kernel set
+bool runFieldKernelFuzz(long long iterations){
+    static const char *contactSeeds[] = {"09171234567", "0917123456", "091712345678", "0917-234567", ""};
+    static const char *dateSeeds[] = {"2027-01-05", "2027-13-05", "2027-00-10", "2027-02-31", "2027-02-32", "20270105", "2027/01/05"};
+    static const char *nameSeeds[] = {"Juan Dela Cruz", "Maria Clara de los Santos y Ibarra", "", " ", "Ana2", "Ab@", "Zz[z"};
+
+    vector<FieldKernels> kernels = availableFieldKernels();
+    mt19937 random(7);
+
+    long long mismatches = 0;
+    for (long long i = 0; i < iterations; i++){
+        string contact = mutateSeed(contactSeeds[random() % 5], random);
+        string date = mutateSeed(dateSeeds[random() % 7], random);
+        string name = mutateSeed(nameSeeds[random() % 7], random);
+        if (random() % 8 == 0){
+            name = string(1 + random() % 70, 'a' + random() % 26); // Long names cross several vector blocks
+            name[random() % name.size()] = fuzzByte(random);
+        }
+
+        bool expectedPair = scalarContactAndDate(contact, date), expectedName = isValidCustomerName(name);
+        for (const FieldKernels &kernel : kernels){
+            if (kernel.contactAndDate(contact, date) != expectedPair || kernel.customerName(name) != expectedName){
+                if (mismatches++ < 5){
+                    cout << kernel.name << " disagrees on \"" << contact << "\", \"" << date << "\", \"" << name << "\"" << endl;
+                }
+            }
+        }
+    }
+    cout << "Fuzzed " << iterations << " rows against " << kernels.size() - 1 << " vector kernel sets: " << mismatches << " mismatches" << endl;
+
+    const string contact = "09171234567", date = "2027-01-05", name = "Maria Clara de los Santos";
+    for (const FieldKernels &kernel : kernels){
+        volatile int sink = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < 10000000; i++){
+            sink = sink + kernel.contactAndDate(contact, date) + kernel.customerName(name);
+        }
+        double nanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / 10000000;
+        cout << setw(8) << left << kernel.name << fixed << setprecision(1) << nanos << " ns per row (contact, date, name)"
+             << (kernel.name == fieldKernels().name ? "  <- selected" : "") << endl;
+    }
+    return mismatches == 0;
+}
+
+// Billing check: known totals for the house menu, then fixed order sets priced again and again with their lines
+// reversed, shuffled, split into single portions and held in other containers. Every bill must come out with the
+// same centavos in every field, VAT included, and the day's totals must not depend on the order bills are added in.
+bool runBillingCheck(int orderSets){
+    const MenuCatalog &catalog = MenuCatalog::instance();
+    BillingEngine billing;
+    long long mismatches = 0;
+    auto sameBill = [](const Bill &a, const Bill &b){
+        return a.reservationFee == b.reservationFee && a.subtotal == b.subtotal && a.discount == b.discount &&
+               a.serviceCharge == b.serviceCharge && a.tax == b.tax && a.total == b.total;
+    };
+
+    if (catalog.contains(8) && catalog.contains(16) && catalog.priceAt(catalog.rowOf(8)) == 50000 && catalog.priceAt(catalog.rowOf(16)) == 12000){ // Kare Kare and Mango Shake
+        vector<pair<int, int>> lines = {{8, 2}, {16, 3}};
+        Bill plain = billing.price(lines, 1), discounted = billing.price(lines, 1, 1000);
+        bool isPlainRight = plain.subtotal == 136000 && plain.serviceCharge == 13600 && plain.tax == 17952 && plain.total == 217552;
+        bool isDiscountedRight = discounted.discount == 13600 && discounted.serviceCharge == 12240 && discounted.tax == 16157 &&
+                                 discounted.total == 200797;
+        mismatches += !isPlainRight + !isDiscountedRight;
+        cout << "2x Kare Kare + 3x Mango Shake: P" << formatPesos(plain.total) << " (VAT P" << formatPesos(plain.tax) << "), with 10% off P"
+             << formatPesos(discounted.total) << (isPlainRight && isDiscountedRight ? "" : "  WRONG, expected P2175.52 and P2007.97") << endl;
+    } else{
+        cout << "menu.txt is not the house menu; skipping the known totals" << endl;
+    }
+
+    if (catalog.itemCount() == 0){
+        cout << "The menu is empty; nothing to price" << endl;
+        return mismatches == 0;
+    }
+
+    { // Day billing through the engine: a cancelled booking's dishes must drop out, before and after replay
+        const string prefix = "billing-check-";
+        auto removeFiles = [&](){
+            for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+                remove((prefix + name).c_str());
+            }
+        };
+        removeFiles();
+        int dishA = catalog.idAt(0), dishB = catalog.idAt((catalog.itemCount() - 1) / 2);
+        string date = dayNumberToDate(todayDayNumber() + 1);
+        Bill expected[] = {billing.price(vector<pair<int, int>>{{dishA, 2}, {dishB, 3}}, 1), billing.price(vector<pair<int, int>>{{dishB, 1}}, 1)};
+        BillingTotals wanted;
+        for (const Bill &bill : expected){
+            BillingEngine::addTo(wanted, bill);
+        }
+
+        BillingTotals live, replayed;
+        bool isSetUp = false;
+        {
+            BookingEngine engine(prefix);
+            engine.setFsyncPolicy(FsyncNone);
+            ReservationSession kept, cancelled;
+            isSetUp = engine.open() &&
+                      engine.registerCustomer(kept, Customer("Billing Check Kept", "09171234567", "kept@example.com", "BILL1")) == BookingOk &&
+                      engine.seatParty(kept, date, 1, 2) == BookingOk && engine.order(kept, dishA, 2) == BookingOk &&
+                      engine.order(kept, dishB, 3) == BookingOk &&
+                      engine.registerCustomer(cancelled, Customer("Billing Check Gone", "09171234568", "gone@example.com", "BILL2")) == BookingOk &&
+                      engine.order(cancelled, dishA, 4) == BookingOk && engine.seatParty(cancelled, date, 2, 2) == BookingOk &&
+                      engine.order(cancelled, dishB, 5) == BookingOk && engine.cancel(cancelled) == BookingOk &&
+                      engine.seatParty(cancelled, date, 3, 2) == BookingOk && engine.order(cancelled, dishB, 1) == BookingOk;
+            live = engine.priceAllOrders();
+            engine.shutdown();
+        }
+        {
+            BookingEngine reopened(prefix);
+            if (reopened.open()){
+                replayed = reopened.priceAllOrders();
+            }
+            reopened.shutdown();
+        }
+        removeFiles();
+
+        bool isRight = isSetUp && live.total == wanted.total && live.tax == wanted.tax && replayed.total == wanted.total && replayed.tax == wanted.tax;
+        mismatches += !isRight;
+        cout << "Day billing with a cancelled booking: P" << formatPesos(live.total) << ", after replay P" << formatPesos(replayed.total)
+             << (isRight ? "" : "  WRONG, expected P" + formatPesos(wanted.total)) << endl;
+    }
+
+    mt19937 random(5);
+    vector<vector<pair<int, int>>> sets(orderSets);
+    vector<int> discounts(orderSets);
+    for (int i = 0; i < orderSets; i++){
+        int lineCount = random() % 12;
+        for (int line = 0; line < lineCount; line++){
+            sets[i].push_back(make_pair(catalog.idAt(random() % catalog.itemCount()), 1 + random() % 5)); // Repeated IDs included
+        }
+        discounts[i] = random() % 4 == 0 ? random() % 3001 : 0;
+    }
+
+    BillingTotals forward, backward;
+    for (int i = 0; i < orderSets; i++){
+        const vector<pair<int, int>> &lines = sets[i];
+        int bookings = i % 3;
+        Bill first = billing.price(lines, bookings, discounts[i]);
+        BillingEngine::addTo(forward, first);
+
+        vector<pair<int, int>> reversed(lines.rbegin(), lines.rend()), shuffled = lines, portions;
+        shuffle(shuffled.begin(), shuffled.end(), random);
+        for (const pair<int, int> &line : lines){
+            portions.insert(portions.end(), line.second, make_pair(line.first, 1));
+        }
+        shuffle(portions.begin(), portions.end(), random);
+        deque<pair<int, int>> queued(lines.begin(), lines.end());
+        pmr::vector<pair<int, int>> arenaLines(lines.begin(), lines.end());
+
+        Bill again[] = {billing.price(lines, bookings, discounts[i]), billing.price(reversed, bookings, discounts[i]),
+                        billing.price(shuffled, bookings, discounts[i]), billing.price(portions, bookings, discounts[i]),
+                        billing.price(queued, bookings, discounts[i]), billing.price(arenaLines, bookings, discounts[i])};
+        for (const Bill &bill : again){
+            if (!sameBill(bill, first) && mismatches++ < 5){
+                cout << "Order set " << i << " priced P" << formatPesos(bill.total) << " and P" << formatPesos(first.total) << endl;
+            }
+        }
+    }
+    for (int i = orderSets - 1; i >= 0; i--){
+        BillingEngine::addTo(backward, billing.price(sets[i], i % 3, discounts[i]));
+    }
+    bool isTotalsSame = forward.subtotal == backward.subtotal && forward.discount == backward.discount &&
+                        forward.serviceCharge == backward.serviceCharge && forward.tax == backward.tax && forward.total == backward.total;
+    mismatches += !isTotalsSame;
+    cout << "Priced " << orderSets << " order sets 7 ways each: " << mismatches << " mismatches; day total P" << formatPesos(forward.total)
+         << " (VAT P" << formatPesos(forward.tax) << ")" << (isTotalsSame ? "" : ", DIFFERENT in reverse order") << endl;
+
+    volatile long long sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < 10; round++){
+        for (int i = 0; i < orderSets; i++){
+            sink = sink + billing.price(sets[i], 1, discounts[i]).total;
+        }
+    }
+    cout << fixed << setprecision(0) << chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (10.0 * orderSets)
+         << " ns per bill" << endl;
+    return mismatches == 0;
+}
+
+// Seating benchmark: synthetic Friday nights where every slot gets more parties than the room can seat.
+// Compares best-fit with joining against taking the first free table that fits.
+void runSeatingBenchmark(int nights){
+    static const int partySizes[] = {1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 4, 5, 6, 6, 7, 8, 8, 10, 12, 14};
+    static const int arrivalsPerSlot = 30;
+
+    TableInventory tables;
+    int roomSeats = 0;
+    for (const TableArea &table : TableArea::restaurantTables()){
+        roomSeats += table.getNumberOfSeats();
+    }
+
+    for (int strategy = 0; strategy < 2; strategy++){
+        mt19937 random(42); // Same arrivals for both strategies
+        long long seatedGuests = 0, seatedParties = 0, turnedAway = 0, slotCount = 0;
+        vector<long long> decisionNanos;
+        decisionNanos.reserve(static_cast<size_t>(nights) * Reservation::totalSlots * arrivalsPerSlot);
+
+        for (int night = 0; night < nights; night++){
+            for (int slot = 0; slot < Reservation::totalSlots; slot++, slotCount++){
+                unsigned int takenTables = 0;
+                for (int arrival = 0; arrival < arrivalsPerSlot; arrival++){
+                    int partySize = partySizes[random() % (sizeof(partySizes) / sizeof(partySizes[0]))];
+                    TableGroup group;
+
+                    auto start = chrono::steady_clock::now();
+                    bool isSeated;
+                    if (strategy == 0){
+                        isSeated = tables.bestFit(takenTables, partySize, group);
+                    } else{
+                        isSeated = false;
+                        for (unsigned int freeTables = tables.tableMask() & ~takenTables; freeTables && !isSeated; freeTables &= freeTables - 1){
+                            int table = lowestSetBit(freeTables) + 1;
+                            if (TableArea::seatsAt(table) >= partySize){
+                                group.tables = 1u << (table - 1);
+                                isSeated = true;
+                            }
+                        }
+                    }
+                    decisionNanos.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+                    if (isSeated){
+                        takenTables |= group.tables;
+                        seatedGuests += partySize;
+                        seatedParties++;
+                    } else{
+                        turnedAway++;
+                    }
+                }
+            }
+        }
+
+        sort(decisionNanos.begin(), decisionNanos.end());
+        cout << (strategy == 0 ? "Best fit with joined tables" : "First free table") << ":" << endl;
+        cout << "  Seated " << seatedParties << " parties, turned away " << turnedAway << endl;
+        cout << "  Utilisation: " << fixed << setprecision(1) << 100.0 * seatedGuests / (static_cast<double>(roomSeats) * slotCount)
+             << "% of seats filled" << endl;
+        cout << "  Decision latency: p50 " << decisionNanos[decisionNanos.size() / 2] << " ns, p99 "
+             << decisionNanos[decisionNanos.size() * 99 / 100] << " ns" << endl;
+    }
+}
+
+// Range query benchmark: a year of calendar where most weeks are booked solid for large parties.
+// Checks the week summary and lookup table against per-day bestFit, then times quarter views and first-N searches.
+bool runRangeBenchmark(int days){
+    static const int quarter = 91, wanted = 5, largeParty = 16;
+    Reservation reservation;
+    TableInventory tables;
+    int firstDay = todayDayNumber();
+    mt19937 random(11);
+    for (int day = firstDay; day < firstDay + days; day++){
+        bool isQuietWeek = (day - firstDay) / 7 % 9 == 8; // Every ninth week still has room for a large party
+        for (int slot = 0; slot < Reservation::totalSlots; slot++){
+            for (int table = 1; table <= 10; table++){
+                if (isQuietWeek ? random() % 4 == 0 : (table >= 5 || random() % 10 < 8)){
+                    reservation.restoreSlot(day, slot, table, 1);
+                }
+            }
+        }
+    }
+
+    long long wrong = 0;
+    vector<unsigned char> summarised(days), scanned(days);
+    for (int party : {0, 2, 6, largeParty}){
+        tables.freeSlotsPerDay(reservation, firstDay, days, party, summarised.data());
+        tables.freeSlotsPerDay(reservation, firstDay, days, party, scanned.data(), false);
+        for (int i = 0; i < days; i++){
+            TableGroup group;
+            int expected = 0;
+            for (int slot = 0; slot < Reservation::totalSlots; slot++){
+                expected += tables.bestFit(Reservation::takenTables(reservation.getSlots(firstDay + i), slot), max(party, 1), group);
+            }
+            wrong += (summarised[i] != expected) + (scanned[i] != expected);
+        }
+    }
+
+    auto timeIt = [](int rounds, const function<void()> &query){ // Nanoseconds per query
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++){
+            query();
+        }
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / rounds;
+    };
+
+    unsigned char freeSlots[quarter];
+    int dayNumbers[wanted];
+    unsigned int slotMasks[wanted];
+    volatile int sink = 0;
+    double perDay = timeIt(2000, [&](){ // What a per-date loop over getSlots and bestFit costs
+        for (int day = firstDay; day < firstDay + quarter; day++){
+            unsigned long long dayWord = reservation.getSlots(day);
+            int count = 0;
+            for (int slot = 0; slot < Reservation::totalSlots; slot++){
+                TableGroup group;
+                count += tables.bestFit(Reservation::takenTables(dayWord, slot), largeParty, group);
+            }
+            freeSlots[day - firstDay] = static_cast<unsigned char>(count);
+        }
+        sink = sink + freeSlots[0];
+    });
+    double scan = timeIt(20000, [&](){
+        tables.freeSlotsPerDay(reservation, firstDay, quarter, largeParty, freeSlots, false);
+        sink = sink + freeSlots[0];
+    });
+    double summary = timeIt(20000, [&](){
+        tables.freeSlotsPerDay(reservation, firstDay, quarter, largeParty, freeSlots);
+        sink = sink + freeSlots[0];
+    });
+    int foundScan = 0, foundSummary = 0;
+    double firstScan = timeIt(20000, [&](){
+        foundScan = tables.firstOpenDates(reservation, firstDay, days, largeParty, wanted, dayNumbers, slotMasks, false);
+    });
+    double firstSummary = timeIt(20000, [&](){
+        foundSummary = tables.firstOpenDates(reservation, firstDay, days, largeParty, wanted, dayNumbers, slotMasks);
+    });
+    wrong += foundScan != foundSummary;
+
+    cout << "Checked " << days << " days for 4 party sizes: " << wrong << " mismatches" << endl;
+    cout << fixed << setprecision(2) << "Quarter view for " << largeParty << " guests:" << endl;
+    cout << "  getSlots + bestFit per date: " << perDay / 1000 << " us" << endl;
+    cout << "  Range scan:                  " << scan / 1000 << " us" << endl;
+    cout << "  Range scan + week summary:   " << summary / 1000 << " us" << endl;
+    cout << "First " << wanted << " open dates for " << largeParty << " guests in " << days << " days (" << foundSummary << " found):" << endl;
+    cout << "  Range scan:                  " << firstScan / 1000 << " us" << endl;
+    cout << "  Range scan + week summary:   " << firstSummary / 1000 << " us" << endl;
+    return wrong == 0;
+}
+
+// Waitlist simulation: oversubscribed nights where turned-away parties wait and 15% of seated parties cancel.
+// Reports how many cancelled covers the waitlist seats again and what each promotion pass costs.
+void runWaitlistBenchmark(int nights){
+    static const int partySizes[] = {1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 4, 5, 6, 6, 7, 8, 8, 10, 12, 14};
+    static const int arrivalsPerSlot = 30;
+
+    struct Seated{
+        int slot;
+        int firstTable;
+        int tableCount;
+        int partySize;
+    };
+
+    Reservation reservation;
+    TableInventory tables;
+    Waitlist waitlist;
+    mt19937 random(19);
+    int firstDay = todayDayNumber();
+    long long cancelledCovers = 0, recoveredCovers = 0, promotedParties = 0, waitedParties = 0;
+    vector<long long> promotionNanos;
+
+    for (int day = firstDay; day < firstDay + nights; day++){
+        string date = dayNumberToDate(day);
+        vector<Seated> seated;
+        for (int slot = 0; slot < Reservation::totalSlots; slot++){
+            for (int arrival = 0; arrival < arrivalsPerSlot; arrival++){
+                int partySize = partySizes[random() % (sizeof(partySizes) / sizeof(partySizes[0]))];
+                TableGroup group;
+                if (tables.bestFit(Reservation::takenTables(reservation.getSlots(day), slot), partySize, group)){
+                    reservation.reserveSlot(date, slot, group.firstTable, group.tableCount);
+                    seated.push_back(Seated{slot, group.firstTable, group.tableCount, partySize});
+                } else{
+                    waitlist.add(day, slot, "W" + to_string(waitedParties), partySize);
+                    waitedParties++;
+                }
+            }
+        }
+
+        shuffle(seated.begin(), seated.end(), random);
+        for (size_t i = 0; i < seated.size(); i++){
+            if (random() % 100 >= 15){
+                continue;
+            }
+            Seated cancelled = seated[i]; // A copy, promotions below may reallocate seated
+            reservation.releaseSlot(date, cancelled.slot, cancelled.firstTable, cancelled.tableCount);
+            cancelledCovers += cancelled.partySize;
+
+            auto start = chrono::steady_clock::now(); // Same loop as BookingEngine::promoteWaiters, without the log
+            Waiter waiter;
+            while (waitlist.next(day, cancelled.slot, tables.largestFreeGroup(Reservation::takenTables(reservation.getSlots(day), cancelled.slot)), waiter)){
+                TableGroup group;
+                tables.bestFit(Reservation::takenTables(reservation.getSlots(day), cancelled.slot), waiter.partySize, group);
+                reservation.reserveSlot(date, cancelled.slot, group.firstTable, group.tableCount);
+                seated.push_back(Seated{cancelled.slot, group.firstTable, group.tableCount, waiter.partySize}); // May cancel too
+                recoveredCovers += waiter.partySize;
+                promotedParties++;
+            }
+            promotionNanos.push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    sort(promotionNanos.begin(), promotionNanos.end());
+    cout << nights << " nights, " << waitedParties << " parties joined the waitlist" << endl;
+    cout << "Cancelled covers: " << cancelledCovers << ", recovered from the waitlist: " << recoveredCovers << " (" << fixed << setprecision(1)
+         << (cancelledCovers ? 100.0 * recoveredCovers / cancelledCovers : 0.0) << "%) by promoting " << promotedParties << " parties" << endl;
+    cout << "Still waiting at close: " << waitlist.size() << endl;
+    if (!promotionNanos.empty()){
+        cout << "Promotion per cancellation: p50 " << promotionNanos[promotionNanos.size() / 2] << " ns, p99 "
+             << promotionNanos[promotionNanos.size() * 99 / 100] << " ns" << endl;
+    }
+}
+
+// No-double-booking stress: every thread races reserve (a random table) and seatParty (a random party) on the same
+// slot, one day per round, with all threads released together. Afterwards every table of that slot must belong to
+// at most one committed booking and the calendar must hold exactly the tables those bookings claim, both in memory
+// and after the log is replayed into a fresh engine.
+bool runBookingStress(int threadCount, int rounds){
+    static const int slot = 3, attemptsPerRound = 4;
+    const string prefix = "booking-stress-";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+            remove((prefix + name).c_str());
+        }
+    };
+
+    removeFiles();
+    int firstDay = todayDayNumber() + 1;
+    vector<vector<ReservationSession>> booked(threadCount); // Every session whose booking committed, per thread
+    atomic<long long> attempts(0), refusals(0), violations(0);
+    auto checkCalendar = [&](BookingEngine &engine, const char *stage){
+        vector<unsigned int> expected(rounds, 0);
+        long long problems = 0;
+        for (const auto &threadSessions : booked){
+            for (const ReservationSession &session : threadSessions){
+                unsigned int tables = Reservation::tableRun(session.reservedTable, session.reservedTableCount);
+                unsigned int &slotTables = expected[dateToDayNumber(session.reservationDate) - firstDay];
+                problems += (slotTables & tables) != 0; // Two bookings on one table
+                slotTables |= tables;
+            }
+        }
+        for (int round = 0; round < rounds; round++){
+            problems += Reservation::takenTables(engine.availability(dayNumberToDate(firstDay + round)), slot - 1) != expected[round];
+        }
+        if (problems){
+            cout << stage << ": " << problems << " double bookings or calendar mismatches" << endl;
+        }
+        violations += problems;
+    };
+
+    {
+        BookingEngine engine(prefix);
+        engine.setFsyncPolicy(FsyncNone);
+        if (!engine.open()){
+            cout << "Cannot open the " << prefix << " files." << endl;
+            return false;
+        }
+        vector<ReservationSession> registered(threadCount);
+        for (int t = 0; t < threadCount; t++){
+            engine.registerCustomer(registered[t], Customer("Stress Tester", "09171234567", "stress@example.com", "B" + to_string(t)));
+        }
+
+        atomic<int> ready(0);
+        atomic<bool> isStarted(false);
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++){
+            workers.emplace_back([&, t](){
+                mt19937 random(2000 + t);
+                ready++;
+                while (!isStarted.load(memory_order_acquire)){
+                    this_thread::yield();
+                }
+                for (int round = 0; round < rounds; round++){
+                    string date = dayNumberToDate(firstDay + round);
+                    for (int attempt = 0; attempt < attemptsPerRound; attempt++){
+                        ReservationSession session = registered[t];
+                        BookingResult result = random() % 2 ? engine.reserve(session, date, slot, 1 + random() % 10)
+                                                             : engine.seatParty(session, date, slot, 1 + random() % 8);
+                        attempts++;
+                        if (result == BookingOk){
+                            booked[t].push_back(session);
+                        } else{
+                            refusals++;
+                            violations += result != SlotTaken && result != TableTooSmall; // Nothing else can go wrong here
+                        }
+                    }
+                }
+            });
+        }
+        while (ready < threadCount){
+            this_thread::yield();
+        }
+        isStarted.store(true, memory_order_release);
+        for (thread &worker : workers){
+            worker.join();
+        }
+        checkCalendar(engine, "In memory");
+        engine.shutdown();
+    }
+    {
+        BookingEngine replayed(prefix);
+        if (!replayed.open()){
+            violations++;
+        } else{
+            checkCalendar(replayed, "After replay");
+        }
+    }
+    removeFiles();
+
+    long long bookings = 0;
+    for (const auto &threadSessions : booked){
+        bookings += threadSessions.size();
+    }
+    cout << threadCount << " threads on one slot over " << rounds << " days: " << attempts.load() << " attempts, " << bookings
+         << " booked, " << refusals.load() << " refused, " << violations.load() << " violations" << endl;
+    return violations == 0;
+}
+
+// Move stress test: threads shove their own bookings around three days of slots and tables with random
+// targets, so moves, cancellations and re-bookings collide constantly. After every step the session must
+// hold exactly what it believes it holds; at the end the calendar must be the non-overlapping union of all
+// bookings, both in memory and after replaying the files. Uses move-stress-* files in the working directory.
+bool runMoveStress(int threadCount, int stepsPerThread){
+    static const int windowDays = 3, sessionsPerThread = 4;
+    const string prefix = "move-stress-";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+            remove((prefix + name).c_str());
+        }
+    };
+    auto holds = [](BookingEngine &engine, const ReservationSession &session){ // The session's tables are taken in its slot
+        unsigned int tables = Reservation::tableRun(session.reservedTable, session.reservedTableCount);
+        return (Reservation::takenTables(engine.availability(session.reservationDate), session.reservationSlot - 1) & tables) == tables;
+    };
+
+    removeFiles();
+    int firstDay = todayDayNumber() + 1;
+    vector<vector<ReservationSession>> sessions(threadCount, vector<ReservationSession>(sessionsPerThread));
+    atomic<long long> violations(0), moves(0), refusals(0);
+    auto checkCalendar = [&](BookingEngine &engine, const char *stage){ // Expected day words from the sessions versus the engine
+        unsigned int expected[windowDays][Reservation::totalSlots] = {};
+        long long problems = 0;
+        for (auto &threadSessions : sessions){
+            for (ReservationSession &session : threadSessions){
+                if (session.bookingIndex < 0){
+                    continue;
+                }
+                unsigned int tables = Reservation::tableRun(session.reservedTable, session.reservedTableCount);
+                unsigned int &slotTables = expected[dateToDayNumber(session.reservationDate) - firstDay][session.reservationSlot - 1];
+                problems += (slotTables & tables) != 0; // Two bookings on one table
+                slotTables |= tables;
+            }
+        }
+        for (int day = 0; day < windowDays; day++){
+            unsigned long long dayWord = engine.availability(dayNumberToDate(firstDay + day));
+            for (int slot = 0; slot < Reservation::totalSlots; slot++){
+                problems += Reservation::takenTables(dayWord, slot) != expected[day][slot];
+            }
+        }
+        if (problems){
+            cout << stage << ": " << problems << " calendar mismatches" << endl;
+        }
+        violations += problems;
+    };
+
+    {
+        BookingEngine engine(prefix);
+        engine.setFsyncPolicy(FsyncNone);
+        if (!engine.open()){
+            cout << "Cannot open the " << prefix << " files." << endl;
+            return false;
+        }
+        for (int t = 0; t < threadCount; t++){
+            for (int i = 0; i < sessionsPerThread; i++){
+                ReservationSession &session = sessions[t][i];
+                engine.registerCustomer(session, Customer("Stress Tester", "09171234567", "stress@example.com", "S" + to_string(t) + "-" + to_string(i)));
+                engine.seatParty(session, dayNumberToDate(firstDay + (t + i) % windowDays), 1 + (t * sessionsPerThread + i) % Reservation::totalSlots, 2);
+            }
+        }
+
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++){
+            workers.emplace_back([&, t](){
+                mt19937 random(1000 + t);
+                for (int step = 0; step < stepsPerThread; step++){
+                    ReservationSession &session = sessions[t][random() % sessionsPerThread];
+                    ReservationSession before = session;
+                    string date = dayNumberToDate(firstDay + random() % windowDays);
+                    int slot = 1 + random() % Reservation::totalSlots;
+                    int action = random() % 20;
+
+                    BookingResult result;
+                    if (action < 12){ // Explicit tables, sometimes joined
+                        int tableCount = 1 + random() % 2;
+                        result = engine.move(session, date, slot, 1 + random() % (10 - tableCount + 1), tableCount);
+                    } else if (action < 17){ // Best fit for a random party
+                        result = engine.move(session, date, slot, 0, 1, 1 + random() % 8);
+                    } else if (action < 19){
+                        result = engine.modify(session, date, slot);
+                    } else{
+                        engine.cancel(session);
+                        result = engine.seatParty(session, date, slot, 2);
+                    }
+
+                    if (result == BookingOk){
+                        moves++;
+                        violations += !holds(engine, session);
+                    } else{
+                        refusals++;
+                        bool isUnchanged = session.bookingIndex == before.bookingIndex && session.reservationDate == before.reservationDate &&
+                                           session.reservationSlot == before.reservationSlot && session.reservedTable == before.reservedTable &&
+                                           session.reservedTableCount == before.reservedTableCount;
+                        violations += action < 19 && (!isUnchanged || (session.bookingIndex >= 0 && !holds(engine, session)));
+                    }
+                    if (random() % 8 == 0){
+                        this_thread::yield(); // Shake up the interleaving
+                    }
+                }
+            });
+        }
+        for (thread &worker : workers){
+            worker.join();
+        }
+        checkCalendar(engine, "In memory");
+        engine.shutdown();
+    }
+    {
+        BookingEngine replayed(prefix);
+        if (!replayed.open()){
+            violations++;
+        } else{
+            checkCalendar(replayed, "After replay");
+        }
+    }
+    removeFiles();
+
+    cout << threadCount << " threads, " << moves.load() << " moves committed, " << refusals.load() << " refused, "
+         << violations.load() << " violations" << endl;
+    return violations == 0;
+}
+
+struct ReplayTally{ // Steps run and failed per script command
+    long long steps[scriptCommandCount] = {};
+    long long failed[scriptCommandCount] = {};
+
+    long long totalSteps() const{
+        long long total = 0;
+        for (long long count : steps){
+            total += count;
+        }
+        return total;
+    }
+};
+
+// Replays generated session scripts for a number of bookings: register, seat, order, and some searches, date
+// checks, moves and cancels, through ScriptRunner on replay-bench-* files in the working directory. With nanos
+// set, each step is timed into nanos[command]. Returns the wall time in seconds, or -1 if the files will not open.
+double replayBookings(long long bookings, ReplayTally &tally, vector<long long> *nanos = nullptr){
+    static const int bookingsPerDay = Reservation::totalSlots * 10; // Ten two-seat parties per slot fill a day
+    static const long long chunkBookings = 10000;
+    static int replayCount = 0; // Customer IDs stay claimed for the whole process, so every replay gets its own
+    const string prefix = "replay-bench-";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+            remove((prefix + name).c_str());
+        }
+    };
+    int menuID = MenuCatalog::instance().idAt(0);
+    string idPrefix = "R" + to_string(replayCount++) + "-";
+
+    removeFiles();
+    double wallSeconds = 0;
+    {
+        BookingEngine engine(prefix);
+        engine.setFsyncPolicy(FsyncNone);
+        if (!engine.open()){
+            return -1;
+        }
+        ScriptRunner runner(engine);
+        int firstDay = todayDayNumber() + 1;
+        int spillDay = firstDay + static_cast<int>(bookings / bookingsPerDay) + 1; // Empty days that moves go to
+
+        vector<ScriptStep> steps;
+        for (long long first = 0; first < bookings; first += chunkBookings){
+            steps.clear();
+            for (long long i = first; i < min(bookings, first + chunkBookings); i++){
+                string session = idPrefix + to_string(i);
+                string date = dayNumberToDate(firstDay + static_cast<int>(i / bookingsPerDay));
+                string slot = to_string(1 + i / 10 % Reservation::totalSlots);
+                steps.push_back(ScriptStep{session, ScriptRegister, {session, "Replay Guest", "09171234567", "replay@example.com"}});
+                steps.push_back(ScriptStep{session, ScriptSeat, {date, slot, "2"}});
+                steps.push_back(ScriptStep{session, ScriptOrder, {to_string(menuID), "2"}});
+                if (i % 10 == 0){
+                    steps.push_back(ScriptStep{session, ScriptSearch, {session}});
+                }
+                if (i % 20 == 0){
+                    steps.push_back(ScriptStep{session, ScriptCheck, {date}});
+                }
+                if (i % 25 == 0){
+                    steps.push_back(ScriptStep{session, ScriptMove, {dayNumberToDate(spillDay + static_cast<int>(i / 250)), slot, "0", "1", "2"}});
+                }
+                if (i % 50 == 0){
+                    steps.push_back(ScriptStep{session, ScriptCancel, {}});
+                }
+                steps.push_back(ScriptStep{session, ScriptClose, {}});
+            }
+
+            auto chunkStart = chrono::steady_clock::now();
+            for (const ScriptStep &step : steps){
+                tally.steps[step.command]++;
+                if (!nanos){
+                    tally.failed[step.command] += runner.run(step) != BookingOk;
+                    continue;
+                }
+                auto start = chrono::steady_clock::now();
+                tally.failed[step.command] += runner.run(step) != BookingOk;
+                nanos[step.command].push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+            }
+            wallSeconds += chrono::duration<double>(chrono::steady_clock::now() - chunkStart).count();
+        }
+        engine.shutdown();
+    }
+    removeFiles();
+    return wallSeconds;
+}
+
+// Write-ahead log throughput: order events committed through ReservationStore under each fsync policy, for up to
+// commitCount commits or two seconds a policy, whichever comes first
+void runWalBenchmark(long long commitCount){
+    static const FsyncPolicy policies[] = {FsyncAlways, FsyncGroup, FsyncNone};
+    static const char *policyNames[] = {"always", "group", "none"};
+    const string prefix = "wal-bench-";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+            remove((prefix + name).c_str());
+        }
+    };
+    int menuID = MenuCatalog::instance().idAt(0);
+
+    for (int i = 0; i < 3; i++){
+        removeFiles();
+        long long committed = 0, failed = 0;
+        double seconds = 0;
+        {
+            ReservationStore store(prefix);
+            store.setFsyncPolicy(policies[i]);
+            if (!store.open()){
+                cout << "Cannot open the " << prefix << " files." << endl;
+                return;
+            }
+            auto start = chrono::steady_clock::now();
+            while (committed < commitCount && (committed % 256 != 0 || chrono::steady_clock::now() - start < chrono::seconds(2))){
+                LogRecord event = {};
+                event.type = LogOrder;
+                copyField(event.customer.customerID, "W" + to_string(committed % 1000));
+                event.menuID = menuID;
+                event.quantity = 1;
+                failed += store.commit(event) < 0;
+                committed++;
+            }
+            failed += !store.sync(); // The tail of the last group counts too
+            seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+        cout << setw(8) << left << policyNames[i] << setw(10) << right << committed << " commits in " << fixed << setprecision(2) << seconds
+             << " s: " << setw(10) << setprecision(0) << committed / seconds << " commits/s, " << setprecision(1) << seconds * 1e6 / committed
+             << " us per commit, " << failed << " failed" << left << endl;
+    }
+    removeFiles();
+}
+
+// Customer lookup at scale: stores customerCount customers, reopens the store as a restart would, and times the
+// ID index behind searchReservationByID against the old linear scan of the customerss.txt text file
+void runLookupBenchmark(long long customerCount){
+    const string prefix = "lookup-bench-", textFile = prefix + "customerss.txt";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat", "customerss.txt"}){
+            remove((prefix + name).c_str());
+        }
+    };
+    auto linearScan = [&](const string &id){ // What the file search did before the index, with its label fixed
+        ifstream file(textFile);
+        string line;
+        while (getline(file, line)){
+            if (line.rfind("Customer ID: ", 0) == 0 && line.compare(13, string::npos, id) == 0){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    removeFiles();
+    {
+        BookingEngine engine(prefix);
+        engine.setFsyncPolicy(FsyncNone);
+        if (!engine.open()){
+            cout << "Cannot open the " << prefix << " files." << endl;
+            return;
+        }
+        auto start = chrono::steady_clock::now();
+        long long failed = 0;
+        ReservationSession session;
+        for (long long i = 0; i < customerCount; i++){
+            string id = "L" + to_string(i);
+            failed += engine.registerCustomer(session, Customer("Lookup Guest", "09171234567", "lookup@example.com", id)) != BookingOk;
+        }
+        engine.shutdown();
+        cout << "Stored " << customerCount << " customers in " << fixed << setprecision(2)
+             << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s, " << failed << " failed" << endl;
+        engine.exportCustomersToText(textFile);
+    }
+    {
+        BookingEngine engine(prefix);
+        auto start = chrono::steady_clock::now();
+        if (!engine.open()){
+            cout << "Cannot reopen the " << prefix << " files." << endl;
+            removeFiles();
+            return;
+        }
+        cout << "Reopened and indexed in " << fixed << setprecision(2) << chrono::duration<double>(chrono::steady_clock::now() - start).count()
+             << " s" << endl;
+
+        mt19937 random(3);
+        vector<string> ids;
+        for (int i = 0; i < 100000; i++){
+            ids.push_back(i % 10 == 0 ? "missing" + to_string(i) : "L" + to_string(random() % customerCount)); // One in ten misses
+        }
+        long long found = 0;
+        Customer customer;
+        start = chrono::steady_clock::now();
+        for (const string &id : ids){
+            found += engine.findCustomer(id, customer);
+        }
+        double indexNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ids.size();
+
+        const int scans = 20;
+        long long scanFound = 0, indexAgrees = 0;
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < scans; i++){
+            bool isFound = linearScan(ids[i]);
+            scanFound += isFound;
+            indexAgrees += isFound == engine.findCustomer(ids[i], customer);
+        }
+        double scanNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / scans;
+
+        cout << "Indexed lookup: " << setprecision(0) << indexNanos << " ns per call (" << found << " of " << ids.size() << " found)" << endl;
+        cout << "Linear scan:    " << scanNanos / 1000 << " us per call (" << scanFound << " of " << scans << " found, index agrees on "
+             << indexAgrees << ")" << endl;
+        cout << "Speedup: " << setprecision(0) << scanNanos / indexNanos << "x" << endl;
+    }
+    removeFiles();
+}
+
+// Replay benchmark at 10k, 100k and 1M bookings, up to maxBookings: latency per command and operations per second
+void runReplayBenchmark(long long maxBookings){
+    for (long long bookings = 10000; bookings <= maxBookings; bookings *= 10){
+        vector<long long> nanos[scriptCommandCount];
+        ReplayTally tally;
+        double wallSeconds = replayBookings(bookings, tally, nanos);
+        if (wallSeconds < 0){
+            cout << "Cannot open the replay-bench- files." << endl;
+            return;
+        }
+
+        long long operations = tally.totalSteps();
+        cout << bookings << " bookings, " << operations << " operations: " << fixed << setprecision(0) << operations / wallSeconds << " ops/s" << endl;
+        cout << "  " << setw(10) << left << "command" << setw(10) << right << "count" << setw(10) << "failed" << setw(12) << "p50 ns"
+             << setw(12) << "p99 ns" << endl;
+        for (int command = 0; command < scriptCommandCount; command++){
+            vector<long long> &commandNanos = nanos[command];
+            if (commandNanos.empty()){
+                continue;
+            }
+            sort(commandNanos.begin(), commandNanos.end());
+            cout << "  " << setw(10) << left << scriptCommandNames[command] << setw(10) << right << commandNanos.size()
+                 << setw(10) << tally.failed[command] << setw(12) << commandNanos[commandNanos.size() / 2] << setw(12) << commandNanos[commandNanos.size() * 99 / 100] << endl;
+        }
+    }
+}
+
+// Metrics overhead: the same replay with the timers switched off and on at run time, best of several rounds.
+// The replay is file-bound and noisy, so the overhead is also estimated from scopes per operation times the cost of
+// one scope. A NO_METRICS build prints its own replay rate, to compare against timers compiled out entirely.
+void runMetricsBenchmark(long long bookings){
+    static const int rounds = 5;
+    long long steps = 0;
+    auto bestRate = [&](double &best){ // One replay; false if the files will not open
+        ReplayTally tally;
+        double seconds = replayBookings(bookings, tally);
+        if (seconds < 0){
+            return false;
+        }
+        best = max(best, tally.totalSteps() / seconds);
+        steps += tally.totalSteps();
+        return true;
+    };
+
+#ifdef NO_METRICS
+    double compiledOut = 0;
+    for (int round = 0; round < rounds; round++){
+        if (!bestRate(compiledOut)){
+            cout << "Cannot open the replay-bench- files." << endl;
+            return;
+        }
+    }
+    cout << "Replay of " << bookings << " bookings, best of " << rounds << ", timers compiled out: " << fixed << setprecision(0)
+         << compiledOut << " ops/s" << endl;
+#else
+    Metrics &metrics = Metrics::instance();
+    double best[2] = {0, 0}; // Operations per second, off then on
+    unsigned long long callsBefore = metrics.totalCalls();
+    for (int round = 0; round < rounds * 2; round++){ // Off, on, on, off...: the files grow, so neither side always goes later
+        bool isOn = (round % 2 == 1) != (round / 2 % 2 == 1);
+        metrics.setEnabled(isOn);
+        if (!bestRate(best[isOn])){
+            cout << "Cannot open the replay-bench- files." << endl;
+            return;
+        }
+    }
+    metrics.setEnabled(true);
+    double scopesPerStep = 2.0 * (metrics.totalCalls() - callsBefore) / steps; // Only the timed half of the rounds counts
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < 10000000; i++){
+        METRIC_SCOPE(MetricCheckDate);
+    }
+    double scopeNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / 10000000;
+
+    cout << "Replay of " << bookings << " bookings, best of " << rounds << ":" << endl;
+    cout << fixed << setprecision(0) << "  Timers off: " << best[0] << " ops/s" << endl;
+    cout << "  Timers on:  " << best[1] << " ops/s" << endl;
+    cout << setprecision(2) << "  Overhead:   " << 100.0 * (best[0] - best[1]) / best[0] << "%" << endl;
+    cout << setprecision(1) << "One instrumented scope: " << scopeNanos << " ns on average (1 in " << METRICS_SAMPLE_EVERY << " timed), "
+         << scopesPerStep << " scopes per operation" << endl;
+    cout << setprecision(2) << "  Estimated overhead: " << 100.0 * scopesPerStep * scopeNanos * best[0] / 1e9 << "%" << endl;
+#endif
+}
+
+// Sessions the way the server keeps them: each registers, is seated, orders three dishes and stays open.
+// Reports heap allocations (only in a -DCOUNT_ALLOCATIONS build) and resident memory per session.
+void runSessionBenchmark(long long sessionCount){
+    static const int bookingsPerDay = Reservation::totalSlots * 10; // Ten two-seat parties per slot fill a day
+    const string prefix = "session-bench-";
+    auto removeFiles = [&](){
+        for (const char *name : {"reservations.wal", "customers.dat", "bookings.dat", "orders.dat"}){
+            remove((prefix + name).c_str());
+        }
+    };
+
+    removeFiles();
+    {
+        BookingEngine engine(prefix);
+        engine.setFsyncPolicy(FsyncNone);
+        if (!engine.open()){
+            cout << "Cannot open the session-bench- files." << endl;
+            return;
+        }
+        const MenuCatalog &catalog = MenuCatalog::instance();
+        int firstDay = todayDayNumber() + 1;
+        unordered_map<string, ReservationSession> sessions;
+        long long failed = 0;
+
+        long long startResident = residentBytes();
+#ifdef COUNT_ALLOCATIONS
+        unsigned long long startAllocations = threadAllocations;
+#endif
+        auto start = chrono::steady_clock::now();
+        for (long long i = 0; i < sessionCount; i++){
+            string id = "S" + to_string(i);
+            ReservationSession &session = sessions[id];
+            failed += engine.registerCustomer(session, Customer("Session Bench Guest", "09171234567", "session.guest@example.com", id)) != BookingOk;
+            failed += engine.seatParty(session, dayNumberToDate(firstDay + static_cast<int>(i / bookingsPerDay)),
+                                       1 + i / 10 % Reservation::totalSlots, 2) != BookingOk;
+            for (int dish = 0; dish < 3; dish++){
+                failed += engine.order(session, catalog.idAt(dish), 1 + dish) != BookingOk;
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        long long residentGrowth = residentBytes() - startResident;
+
+        cout << sessionCount << " sessions in " << fixed << setprecision(2) << seconds << " s, " << failed << " failed steps" << endl;
+#ifdef COUNT_ALLOCATIONS
+        cout << "Heap allocations: " << setprecision(1) << double(threadAllocations - startAllocations) / sessionCount << " per session" << endl;
+#else
+        cout << "Heap allocations: not counted, build with -DCOUNT_ALLOCATIONS" << endl;
+#endif
+        if (startResident > 0){
+            cout << "Resident memory: +" << setprecision(1) << residentGrowth / 1048576.0 << " MB, " << setprecision(0)
+                 << double(residentGrowth) / sessionCount << " bytes per session" << endl;
+        }
+        cout << "sizeof(ReservationSession): " << sizeof(ReservationSession) << " bytes, sizeof(Customer): " << sizeof(Customer) << " bytes" << endl;
+        engine.shutdown();
+    }
+    removeFiles();
+}
+
+class LineWriteBuffer : public streambuf{ // cout as a line-buffered terminal sees it: one write per line or flush
+private:
+    int outputFile;
+    string line;
+
+    void writeLine(){
+        if (line.empty()){
+            return;
+        }
+#ifdef _WIN32
+        int written = _write(outputFile, line.data(), static_cast<unsigned int>(line.size()));
+#else
+        ssize_t written = write(outputFile, line.data(), line.size());
+#endif
+        if (written >= 0){
+            writes++;
+        }
+        line.clear();
+    }
+
+protected:
+    int overflow(int c) override{
+        if (c != EOF){
+            line += static_cast<char>(c);
+            if (c == '\n'){
+                writeLine();
+            }
+        }
+        return c;
+    }
+
+    int sync() override{
+        writeLine();
+        return 0;
+    }
+
+public:
+    long long writes = 0;
+
+    explicit LineWriteBuffer(int outputFile) : outputFile(outputFile) {}
+};
+
+void drawSampleScreen(){ // The main menu and the first menu category, then a prompt
+    cout << "Welcome to Sinaing Society Reservation System!" << endl << endl;
+    cout << "Please choose an option:" << endl;
+    cout << "1. Check Available Dates" << endl;
+    cout << "2. View Available Table Areas" << endl;
+    cout << "3. View Menu" << endl;
+    cout << "4. Make a Reservation" << endl;
+    cout << "5. View Reservation" << endl;
+    cout << "6. Exit" << endl << endl;
+    Menu(0).displayMenu();
+    cout << endl << "Enter your choice: ";
+    cout.flush(); // Where cin would flush it before reading
+}
+
+// Console rendering, before and after: the sample screen drawn with a shell spawned for cls and for pause and a
+// write per line, then through a Terminal. Both draw to the null device; frame latency is per screen.
+void runConsoleBenchmark(int screens){
+#ifdef _WIN32
+    int nullFile = _open("NUL", _O_WRONLY);
+#else
+    int nullFile = ::open("/dev/null", O_WRONLY);
+#endif
+    if (nullFile < 0){
+        cout << "Cannot open the null device." << endl;
+        return;
+    }
+    streambuf *savedOutput = cout.rdbuf();
+    auto percentile = [](vector<double> &nanos, int percent){
+        sort(nanos.begin(), nanos.end());
+        return nanos[nanos.size() * percent / 100] / 1000;
+    };
+
+    vector<double> beforeNanos, afterNanos;
+    long long beforeWrites = 0;
+    {
+#ifdef _WIN32
+        int savedError = _dup(2);
+        _dup2(nullFile, 2);
+#else
+        int savedError = dup(2);
+        dup2(nullFile, 2); // Linux shells complain that there is no cls
+#endif
+        LineWriteBuffer lines(nullFile);
+        cout.rdbuf(&lines);
+        for (int screen = 0; screen < screens; screen++){
+            auto start = chrono::steady_clock::now();
+            if (system("cls") < 0){ // The old clear
+                break;
+            }
+            drawSampleScreen();
+            if (system("cls") < 0){ // Stands in for pause's shell; pause itself would wait for a key
+                break;
+            }
+            beforeNanos.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+        }
+        cout.rdbuf(savedOutput);
+        beforeWrites = lines.writes;
+#ifdef _WIN32
+        _dup2(savedError, 2);
+        _close(savedError);
+#else
+        dup2(savedError, 2);
+        close(savedError);
+#endif
+    }
+
+    long long afterWrites = 0;
+    {
+        Terminal terminal(nullFile, true);
+        for (int screen = 0; screen < screens * 100; screen++){ // Far cheaper, so more screens for a steady figure
+            auto start = chrono::steady_clock::now();
+            clearScreen();
+            drawSampleScreen();
+            terminal.present(); // Where cin would present it before reading
+            afterNanos.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+        }
+        afterWrites = terminal.writeCount();
+    }
+#ifdef _WIN32
+    _close(nullFile);
+#else
+    close(nullFile);
+#endif
+    if (beforeNanos.empty()){
+        cout << "Cannot run the shell." << endl;
+        return;
+    }
+
+    cout << "Sample screen, frame latency in microseconds:" << endl;
+    cout << setw(10) << left << "Renderer" << setw(10) << right << "Screens" << setw(10) << "Median" << setw(10) << "p99"
+         << setw(14) << "Writes/screen" << setw(14) << "Shells/screen" << endl;
+    cout << fixed << setprecision(1);
+    cout << setw(10) << left << "system()" << setw(10) << right << beforeNanos.size() << setw(10) << percentile(beforeNanos, 50)
+         << setw(10) << percentile(beforeNanos, 99) << setw(14) << double(beforeWrites) / beforeNanos.size() << setw(14) << 2 << endl;
+    cout << setw(10) << left << "Terminal" << setw(10) << right << afterNanos.size() << setw(10) << percentile(afterNanos, 50)
+         << setw(10) << percentile(afterNanos, 99) << setw(14) << double(afterWrites) / afterNanos.size() << setw(14) << 0 << endl;
+}
+
+class CountingSink : public streambuf{ // Discards output, counting the writes that reach the buffer
+protected:
+    int overflow(int c) override{
+        writes++;
+        bytes++;
+        return traits_type::not_eof(c);
+    }
+
+    streamsize xsputn(const char *, streamsize count) override{
+        writes++;
+        bytes += count;
+        return count;
+    }
+
+public:
+    long long writes = 0;
+    long long bytes = 0;
+};
+
+// Menu rendering per view of the full menu: every table formatted with iostream manipulators, as displayMenu
+// used to do, against the cached tables. Both go to a sink, so only the rendering is timed.
+void runMenuBenchmark(int views){
+    const MenuCatalog &catalog = MenuCatalog::instance();
+    CountingSink formattedSink, cachedSink;
+    ostream formatted(&formattedSink), cached(&cachedSink);
+
+    auto start = chrono::steady_clock::now();
+    for (int view = 0; view < views; view++){
+        for (int category = 0; category < catalog.categoryCount(); category++){
+            Menu::formatTable(formatted, category);
+            formatted << "\n";
+        }
+    }
+    double formattedNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / views;
+
+    start = chrono::steady_clock::now();
+    Menu::fullMenu(); // The one render the cache pays for
+    double firstNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for (int view = 0; view < views; view++){
+        cached << Menu::fullMenu();
+    }
+    double cachedNanos = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / views;
+
+    cout << "Full menu, " << catalog.categoryCount() << " categories, " << views << " views (catalog version " << hex << setw(8)
+         << setfill('0') << catalog.version() << dec << setfill(' ') << "):" << endl;
+    cout << setw(10) << left << "Renderer" << setw(12) << right << "ns/view" << setw(14) << "Writes/view" << setw(12) << "Bytes/view" << endl;
+    cout << fixed << setprecision(0);
+    cout << setw(10) << left << "Formatted" << setw(12) << right << formattedNanos << setw(14) << double(formattedSink.writes) / views
+         << setw(12) << double(formattedSink.bytes) / views << endl;
+    cout << setw(10) << left << "Cached" << setw(12) << right << cachedNanos << setw(14) << double(cachedSink.writes) / views
+         << setw(12) << double(cachedSink.bytes) / views << endl;
+    cout << "First render into the cache: " << firstNanos << " ns" << endl;
+}
+
+int main(int argc, char *argv[]){
+    Reservation reservation; // Non-singleton
+    Customer customer;       // Non-singleton
+    Menu menu;
+    TableArea tableArea(0, 0, true); // Non-singleton
+
+#ifdef __linux__
+    if (argc >= 3 && string(argv[1]) == "--loadgen"){ // --loadgen <port> [connections] [seconds] against localhost
+        runLoadGenerator(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : 16, argc > 4 ? atoi(argv[4]) : 10);
+        return 0;
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-kitchen"){ // --bench-kitchen [producers] [tickets per producer]
+        runKitchenBenchmark(argc > 2 ? max(atoi(argv[2]), 1) : 4, argc > 3 ? max(atoi(argv[3]), 1) : 250000);
+        return 0;
+    }
+#endif
+
+    if (argc >= 2 && string(argv[1]) == "--bench-dates"){ // Exit status 1 on any calendar mismatch
+        return runDateBenchmark() ? 0 : 1;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-validators"){ // --bench-validators [inputs]; exit status 1 on any mismatch
+        return runValidatorBenchmark(argc > 2 ? max(atoll(argv[2]), 1LL) : 300000) ? 0 : 1;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--fuzz-validators"){ // --fuzz-validators [iterations]; exit status 1 on any mismatch
+        return runFieldKernelFuzz(argc > 2 ? atoll(argv[2]) : 1000000) ? 0 : 1;
+    }
+
+    if (argc == 3 && string(argv[1]) == "--bench-validate"){ // --bench-validate <csv or jsonl>; touches no data files
+        runValidationBenchmark(argv[2]);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-billing"){ // --bench-billing [order sets]; exit status 1 if any total differs
+        return runBillingCheck(argc > 2 ? max(atoi(argv[2]), 1) : 10000) ? 0 : 1;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-seating"){ // --bench-seating [nights]; touches no data files
+        runSeatingBenchmark(argc > 2 ? max(atoi(argv[2]), 1) : 1000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-console"){ // --bench-console [screens]: system() clears against Terminal frames
+        runConsoleBenchmark(argc > 2 ? max(atoi(argv[2]), 1) : 200);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-sessions"){ // --bench-sessions [sessions]: allocations and memory per open session
+        runSessionBenchmark(argc > 2 ? max(atoll(argv[2]), 1LL) : 100000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-menu"){ // --bench-menu [views]: formatted against cached menu tables
+        runMenuBenchmark(argc > 2 ? max(atoi(argv[2]), 1) : 100000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-metrics"){ // --bench-metrics [bookings]: timer overhead on the replay
+        runMetricsBenchmark(argc > 2 ? max(atoll(argv[2]), 1000LL) : 100000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-wal"){ // --bench-wal [commits]: commits per second for each fsync policy
+        runWalBenchmark(argc > 2 ? max(atoll(argv[2]), 1LL) : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-lookup"){ // --bench-lookup [customers]: ID index against a linear scan
+        runLookupBenchmark(argc > 2 ? max(atoll(argv[2]), 1LL) : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-replay"){ // --bench-replay [max bookings]: 10k, 100k, 1M
+        runReplayBenchmark(argc > 2 ? max(atoll(argv[2]), 10000LL) : 1000000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--stress-booking"){ // --stress-booking [threads] [days]; exit status 1 on any double booking
+        return runBookingStress(argc > 2 ? max(atoi(argv[2]), 1) : 64, argc > 3 ? max(atoi(argv[3]), 1) : 2000) ? 0 : 1;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--stress-moves"){ // --stress-moves [threads] [steps per thread]; exit status 1 on any violation
+        return runMoveStress(argc > 2 ? max(atoi(argv[2]), 1) : 8, argc > 3 ? max(atoi(argv[3]), 1) : 20000) ? 0 : 1;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-waitlist"){ // --bench-waitlist [nights]; touches no data files
+        runWaitlistBenchmark(argc > 2 ? max(atoi(argv[2]), 1) : 1000);
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--bench-range"){ // --bench-range [days]; exit status 1 on any mismatch
+        return runRangeBenchmark(argc > 2 ? max(atoi(argv[2]), 91) : 365) ? 0 : 1;
+    }
 
     ReservationSystem *reservationSystem = ReservationSystem::getInstance(); // Access the singleton instance of ReservationSystem
 
+    BookingEngine &engine = reservationSystem->getEngine();
+
+    string metricsFile;
+    int metricsInterval = 10;
+    for (int i = 1; i < argc; i++){ // --fsync=always|group|none picks when committed reservations reach the disk
+        string option = argv[i];
+        if (option == "--fsync=always"){
+            engine.setFsyncPolicy(FsyncAlways);
+        } else if (option == "--fsync=group"){
+            engine.setFsyncPolicy(FsyncGroup);
+        } else if (option == "--fsync=none"){
+            engine.setFsyncPolicy(FsyncNone);
+        } else if (option.compare(0, 15, "--metrics-file=") == 0){ // Prometheus text, rewritten every --metrics-interval=<s>
+            metricsFile = option.substr(15);
+        } else if (option.compare(0, 19, "--metrics-interval=") == 0){
+            metricsInterval = atoi(option.c_str() + 19);
+        }
+    }
+#ifndef NO_METRICS
+    static MetricsFileWriter metricsWriter; // Static: the console leaves through exit(), which still runs its final write
+    if (!metricsFile.empty()){
+        metricsWriter.start(metricsFile, metricsInterval);
+    }
+#else
+    (void)metricsInterval;
+    if (!metricsFile.empty()){
+        cout << "Metrics are compiled out of this build; ignoring --metrics-file." << endl;
+    }
+#endif
+
+#ifdef __linux__
+    if (argc >= 3 && string(argv[1]) == "--serve"){ // --serve <port> [--public]: online channel instead of the console menu
+        bool isPublic = argc > 3 && string(argv[3]) == "--public";
+        BookingServer server(engine);
+        if (!server.listenOn(atoi(argv[2]), isPublic)){
+            cout << "Error: Unable to listen on port " << argv[2] << "." << endl;
+            return 1;
+        }
+        cout << "Listening on " << (isPublic ? "all interfaces" : "127.0.0.1") << ", port " << argv[2] << "." << endl;
+        server.run();
+        return 0;
+    }
+#endif
+
+    if (argc == 3 && string(argv[1]) == "--batch"){ // --batch <script>: session scripts with no console I/O, results on stdout
+        ScriptRunner runner(engine);
+        long long failed = runner.runFile(argv[2], cout);
+        if (failed < 0){
+            cout << "Error: Unable to open " << argv[2] << "." << endl;
+            return 1;
+        }
+        engine.shutdown();
+        return failed == 0 ? 0 : 2;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--end-of-day"){ // Price every order on file
+        BillingTotals totals = engine.priceAllOrders();
+        cout << "Bills: " << totals.bills << endl;
+        cout << "Food subtotal: P" << formatPesos(totals.subtotal) << endl;
+        cout << "Discounts: P" << formatPesos(totals.discount) << endl;
+        cout << "Service charge: P" << formatPesos(totals.serviceCharge) << endl;
+        cout << "VAT: P" << formatPesos(totals.tax) << endl;
+        cout << "Total: P" << formatPesos(totals.total) << endl;
+        return 0;
+    }
+    if (argc >= 3 && string(argv[1]) == "--import"){ // --import <csv or jsonl> [threads]
+        ImportReport report;
+        auto start = chrono::steady_clock::now();
+        if (!engine.importReservations(argv[2], report, argc > 3 ? atoi(argv[3]) : 0)){
+            cout << "Error: Unable to import " << argv[2] << "." << endl;
+            return 1;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Read " << report.rows << " rows in " << fixed << setprecision(2) << seconds << " s: " << report.imported << " bookings imported ("
+             << report.newCustomers << " new customers), " << report.rejected << " rejected." << endl;
+        if (report.rejected > 0){
+            cout << "Rejected rows are listed in " << argv[2] << ".rejected" << endl;
+        }
+        return 0;
+    }
+    if (argc == 3 && string(argv[1]) == "--export"){ // Bookings as CSV, or JSON Lines for .json/.jsonl
+        long long exported = engine.exportReservations(argv[2]);
+        if (exported < 0){
+            cout << "Error: Unable to write " << argv[2] << "." << endl;
+            return 1;
+        }
+        cout << "Exported " << exported << " bookings to " << argv[2] << "." << endl;
+        return 0;
+    }
+    if (argc == 3 && string(argv[1]) == "--export-text"){ // Dump customers.dat in the old customerss.txt format
+        int exported = engine.exportCustomersToText(argv[2]);
+        if (exported < 0){
+            cout << "Error: Unable to open " << argv[2] << " for writing." << endl;
+            return 1;
+        }
+        cout << "Exported " << exported << " customers to " << argv[2] << "." << endl;
+        return 0;
+    }
+    if (argc == 3 && string(argv[1]) == "--import-text"){ // Load a customerss.txt-style file into customers.dat
+        int skipped;
+        int imported = engine.importCustomersFromText(argv[2], skipped);
+        if (imported < 0){
+            cout << "Error: Unable to open " << argv[2] << " for reading." << endl;
+            return 1;
+        }
+        cout << "Imported " << imported << " customers from " << argv[2] << " (" << skipped << " skipped)." << endl;
+        return 0;
+    }
+
+    static Terminal terminal(1, Terminal::isTerminal(1)); // Static: exit() still shows the last frame
     bool systemRunning = true; // Flag to keep the system running
 
     while (systemRunning){
-        system("cls"); // Main Menu
+        engine.commitPending(); // Everything from the last flow is durable before the next prompt
+        clearScreen(); // Main Menu
         cout << "Welcome to Sinaing Society Reservation System!" << endl << endl;
         cout << "Please choose an option:" << endl;
         cout << "1. Check Available Dates" << endl;
@@ -838,7 +7174,7 @@ int main(){
 
         int menuChoice;
         cin >> menuChoice;
-        system("cls");
+        clearScreen();
 
         switch (menuChoice){
         case 1:{ // Check Available Dates
@@ -846,8 +7182,9 @@ int main(){
             bool isValidDate = false;
 
             while (!isValidDate){
-                system("cls");
+                clearScreen();
                 cout << "CHECK AVAILABLE DATES" << endl << endl;
+                reservationSystem->showHeatmap(0); // Quarter view before asking for a date
                 cout << "Enter reservation date (YYYY-MM-DD): ";
                 cin >> date;
 
@@ -856,14 +7193,14 @@ int main(){
                     if (reservation.checkIfValidDate(date)){ // Additional logic to check availability
                         isValidDate = true; // Exit loop if valid
                         cout << date << " is available for reservation!" << endl << endl;
-                        system("pause");
+                        waitForKey();
                     } else{
                         cout << "The entered date is not available for reservation. Try another date." << endl << endl;
-                        system("pause");
+                        waitForKey();
                     }
                 } else{
                     cout << "Invalid date format or the date is in the past. Please follow the format (YYYY-MM-DD)." << endl << endl;
-                    system("pause");
+                    waitForKey();
                 }
             }
             break; // exit case 1
@@ -872,7 +7209,7 @@ int main(){
         case 2: // View Available Table Areas
             cout << "VIEW AVAILABLE TABLE AREAS" << endl << endl;
             tableArea.viewAvailableAreas(); // display all tables
-            system("pause");
+            waitForKey();
             break; // exit case 2
 
         case 3:{ // View Menu
@@ -925,12 +7262,13 @@ int main(){
                 cout << "Returning to main menu..." << endl;
             }
 
-            system("pause");
+            waitForKey();
             break; // exit case 5
         }
 
         case 6: // Exit
             cout << endl << "Thank you for using Sinaing Society Reservation System. Goodbye!" << endl;
+            engine.shutdown();
             exit(0);
 
         default: